@@ -0,0 +1,60 @@
+#ifndef HOT_TEACUP_COMPRESSION_H
+#define HOT_TEACUP_COMPRESSION_H
+
+#include "types.h"
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace http {
+
+/// Compression requires the library to be built with HOT_TEACUP_ENABLE_COMPRESSION, which links it with zlib.
+/// Otherwise negotiateContentEncoding() always returns ContentEncoding::Identity
+/// and compressing with other encodings throws std::runtime_error.
+constexpr bool compressionEnabled()
+{
+#ifdef HOT_TEACUP_ENABLE_COMPRESSION
+    return true;
+#else
+    return false;
+#endif
+}
+
+constexpr auto defaultCompressionLevel = -1;
+
+/// Chooses gzip or deflate according to the qvalues of the Accept-Encoding header value,
+/// returns ContentEncoding::Identity if neither is acceptable
+ContentEncoding negotiateContentEncoding(std::string_view acceptEncoding);
+
+/// Compresses the data and appends the result to the output.
+/// zlib streams are kept by the calling thread and reused between calls.
+void compress(
+        std::string_view data,
+        ContentEncoding encoding,
+        std::string& output,
+        int level = defaultCompressionLevel);
+
+namespace detail {
+class DeflateStream;
+}
+
+/// Compresses data passed in parts, to avoid keeping both the whole uncompressed and compressed content in memory
+class CompressionStream {
+public:
+    explicit CompressionStream(ContentEncoding encoding, int level = defaultCompressionLevel);
+    ~CompressionStream();
+    CompressionStream(CompressionStream&&) noexcept;
+    CompressionStream& operator=(CompressionStream&&) noexcept;
+
+    /// Compresses the next part of the data and appends the available output
+    void write(std::string_view data, std::string& output);
+    /// Appends the remaining output, the stream can't be written to afterwards
+    void finish(std::string& output);
+
+private:
+    std::unique_ptr<detail::DeflateStream> stream_;
+};
+
+} //namespace http
+
+#endif //HOT_TEACUP_COMPRESSION_H
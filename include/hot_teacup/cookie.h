@@ -1,8 +1,11 @@
 #ifndef HOT_TEACUP_COOKIE_H
 #define HOT_TEACUP_COOKIE_H
 
-#include "header.h"
+#include "types.h"
+#include <array>
 #include <chrono>
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -10,10 +13,14 @@
 
 namespace http {
 class CookieView;
+namespace detail {
+struct CookieTemplateData;
+}
 
 class Cookie {
 
 public:
+    /// Attributes of the view unknown to the library, e.g. Priority, are kept and written after the known ones
     explicit Cookie(const CookieView& cookieView);
     Cookie(std::string name,
            std::string value,
@@ -28,23 +35,60 @@ public:
     std::optional<std::string> domain() const;
     std::optional<std::string> path() const;
     std::optional<std::chrono::seconds> maxAge() const;
+    std::optional<std::string> expires() const;
+    std::optional<CookieSameSite> sameSite() const;
     bool isSecure() const;
+    bool isHttpOnly() const;
+    bool isPartitioned() const;
     bool isRemoved() const;
 
     void setDomain(std::string domain);
     void setPath(std::string path);
     void setMaxAge(const std::chrono::seconds& maxAge);
+    /// Sets the Expires attribute, the date is expected to be in the IMF-fixdate format
+    void setExpires(std::string date);
+    void setExpires(std::chrono::system_clock::time_point time);
+    void setSameSite(CookieSameSite sameSite);
     void setSecure();
+    void setHttpOnly();
+    void setPartitioned();
     void setRemoved();
 
     std::string toString() const;
     friend bool operator==(const Cookie& lhs, const Cookie& rhs);
+    friend class CookieTemplate;
 
 private:
-    explicit Cookie(Header header);
+    void appendAttribute(std::string& result, detail::CookieAttribute attribute) const;
+    std::string_view attributeValue(detail::CookieAttribute attribute) const;
+    void setAttributeValue(detail::CookieAttribute attribute, std::string_view value);
+    std::string_view otherAttributes() const;
 
 private:
-    Header header_;
+    std::string name_;
+    std::string value_;
+    /// Values of Domain, Path and Expires followed by the formatted attributes unknown to the library,
+    /// each value ends at its offset in attributeValueEnds_, so unset attributes take no space
+    std::string attributeData_;
+    std::shared_ptr<const detail::CookieTemplateData> template_;
+    std::chrono::seconds maxAge_ = {};
+    std::array<std::uint32_t, 3> attributeValueEnds_ = {};
+    CookieSameSite sameSite_ = {};
+    /// The attribute values above are set only if they're in the list
+    detail::CookieAttributeList attributes_;
+};
+
+/// Attributes shared by many cookies, formatted once when the template is created.
+/// Serializing a cookie made by the template writes its name, value, the template attributes
+/// and the attributes set on the cookie afterwards, which replace the template ones of the same kind.
+class CookieTemplate {
+public:
+    /// Takes the attributes of the prototype, its name and value aren't used
+    explicit CookieTemplate(const Cookie& prototype);
+    Cookie makeCookie(std::string name, std::string value) const;
+
+private:
+    std::shared_ptr<const detail::CookieTemplateData> data_;
 };
 
 std::string cookiesToString(const std::vector<Cookie>& cookies);
@@ -2,13 +2,20 @@
 #define HOT_TEACUP_COOKIE_VIEW_H
 
 #include "header_view.h"
+#include "parse_limits.h"
+#include "parse_result.h"
+#include "types.h"
 #include <chrono>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
 
 namespace http {
+namespace detail {
+struct CookieViewAttributes;
+}
 
 class CookieView {
 
@@ -20,21 +27,35 @@ public:
     std::optional<std::string_view> domain() const;
     std::optional<std::string_view> path() const;
     std::optional<std::chrono::seconds> maxAge() const;
+    /// Returns the unparsed date of the Expires attribute
+    std::optional<std::string_view> expires() const;
+    std::optional<CookieSameSite> sameSite() const;
     bool isSecure() const;
+    bool isHttpOnly() const;
+    bool isPartitioned() const;
     bool isRemoved() const;
-    const HeaderView& asHeader() const;
+    /// Builds a Set-Cookie header from the cookie name, value and attributes, the header refers to the cookie data.
+    /// Known attributes are written first, a repeated one only once with its last value,
+    /// followed by the attributes unknown to the library (e.g. Priority) in their original order.
+    HeaderView asHeader() const;
 
     friend bool operator==(const CookieView& lhs, const CookieView& rhs);
     friend std::optional<CookieView> cookieFromHeader(const HeaderView& header);
+    friend class Cookie;
 
 private:
-    explicit CookieView(HeaderView header);
+    explicit CookieView(const HeaderView& header);
+    bool hasAttribute(detail::CookieAttribute attribute) const;
 
 private:
-    HeaderView header_;
+    std::string_view name_;
+    std::string_view value_;
+    /// Only cookies read from a Set-Cookie header have attributes, request cookies are just a name and a value
+    std::shared_ptr<const detail::CookieViewAttributes> attributes_;
 };
 
 std::vector<CookieView> cookiesFromString(std::string_view input);
+ParseResult<std::vector<CookieView>> cookiesFromString(std::string_view input, const ParseLimits& limits);
 std::optional<CookieView> cookieFromHeader(const HeaderView& header);
 
 } //namespace http
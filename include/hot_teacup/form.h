@@ -2,7 +2,10 @@
 #define HOT_TEACUP_FORM_H
 
 #include "types.h"
+#include <cstddef>
+#include <filesystem>
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -12,15 +15,27 @@
 namespace http {
 class FormFieldView;
 
+/// Files larger than sizeThreshold are written to the directory (system temporary directory if empty)
+/// instead of being copied to FormField. Spooled files are created with owner-only permissions
+/// and removed when the last FormField referencing them is destroyed.
+/// Spooling happens after the whole request body has been read into memory, so it doesn't lower
+/// the peak memory usage, it only keeps large files out of the memory retained by the Form.
+struct FormFileSpooling {
+    std::size_t sizeThreshold = 1024 * 1024;
+    std::filesystem::path directory = {};
+};
+
 class FormField {
     struct FormFile {
         std::string fileData;
         std::string fileName;
         std::optional<std::string> mimeType;
+        std::shared_ptr<const std::filesystem::path> filePath;
     };
 
 public:
     explicit FormField(const FormFieldView&);
+    FormField(const FormFieldView&, const FormFileSpooling&);
     explicit FormField(std::string value = {});
     FormField(std::string fileData, std::string fileName, std::optional<std::string> fileType = {});
 
@@ -30,10 +45,14 @@ public:
     const std::string& fileName() const;
     const std::string& fileType() const;
     const std::string& value() const;
+    /// Returns the path of the spooled file, value() of a spooled file is empty
+    const std::filesystem::path& filePath() const;
+    bool isFileSpooled() const;
 
 private:
     std::variant<std::string, FormFile> value_;
     static inline const std::string valueNotFound = {};
+    static inline const std::filesystem::path pathNotFound = {};
 };
 
 using Form = std::map<std::string, FormField>;
@@ -41,6 +60,7 @@ std::string multipartFormToString(const Form& form, const std::string& formBound
 std::string urlEncodedFormToString(const Form& form);
 
 Form makeForm(const std::map<std::string, FormFieldView>& formView);
+Form makeForm(const std::map<std::string, FormFieldView>& formView, const FormFileSpooling& fileSpooling);
 
 } //namespace http
 
@@ -1,6 +1,8 @@
 #ifndef HOT_TEACUP_FORM_VIEW_H
 #define HOT_TEACUP_FORM_VIEW_H
 
+#include "parse_limits.h"
+#include "parse_result.h"
 #include "types.h"
 #include <map>
 #include <optional>
@@ -36,6 +38,12 @@ private:
 using FormView = std::map<std::string, FormFieldView>;
 
 FormView formFromString(std::string_view contentTypeHeader, std::string_view contentFields);
+/// Unlike the overload without limits, reports malformed multipart forms instead of returning the fields parsed so far.
+/// A content type other than a form results in an empty FormView.
+ParseResult<FormView> formFromString(
+        std::string_view contentTypeHeader,
+        std::string_view contentFields,
+        const ParseLimits& limits);
 
 } //namespace http
 
@@ -1,6 +1,8 @@
 #ifndef HOT_TEACUP_HEADER_H
 #define HOT_TEACUP_HEADER_H
 
+#include "header_view.h"
+#include "small_vector.h"
 #include "types.h"
 #include <map>
 #include <optional>
@@ -9,8 +11,6 @@
 #include <vector>
 
 namespace http {
-class HeaderParamView;
-class HeaderView;
 
 class HeaderParam {
 public:
@@ -27,6 +27,9 @@ private:
     static inline const std::string valueNotFound;
 };
 
+/// Owned headers usually have at most one param, like Content-Type charset
+using HeaderParamList = SmallVector<HeaderParam, 1>;
+
 class Header {
 public:
     explicit Header(const HeaderView&);
@@ -39,16 +42,17 @@ public:
     const std::string& name() const;
     const std::string& value() const;
     const std::string& param(std::string_view name) const;
-    const std::vector<HeaderParam>& params() const;
+    const HeaderParamList& params() const;
     bool hasParam(std::string_view name) const;
 
 private:
     std::string name_;
     std::string value_;
-    std::vector<HeaderParam> params_;
+    HeaderParamList params_;
     HeaderQuotingMode quotingMode_ = HeaderQuotingMode::None;
 };
 
+HeaderParamList makeHeaderParams(const HeaderParamViewList& headerParamViewList);
 std::vector<HeaderParam> makeHeaderParams(const std::vector<HeaderParamView>& headerParamViewList);
 std::vector<Header> makeHeaders(const std::vector<HeaderView>& headerViewList);
 
@@ -1,6 +1,9 @@
 #ifndef HOT_TEACUP_HEADER_VIEW_H
 #define HOT_TEACUP_HEADER_VIEW_H
 
+#include "parse_limits.h"
+#include "parse_result.h"
+#include "small_vector.h"
 #include <map>
 #include <optional>
 #include <string>
@@ -9,6 +12,7 @@
 
 namespace http {
 
+/// Header param, a part without '=' like "Secure" or "no-cache" is a flag param without a value
 class HeaderParamView {
 public:
     explicit HeaderParamView(std::string_view name);
@@ -22,22 +26,28 @@ private:
     std::optional<std::string_view> value_;
 };
 
+/// Headers rarely have more than two params, e.g. Content-Disposition name and filename, so they're stored
+/// without a heap allocation
+using HeaderParamViewList = SmallVector<HeaderParamView, 2>;
+
 class HeaderView {
 public:
-    HeaderView(std::string_view name, std::string_view value, std::vector<HeaderParamView> params);
+    HeaderView(std::string_view name, std::string_view value, HeaderParamViewList params);
     std::string_view name() const;
     std::string_view value() const;
     std::string_view param(std::string_view name) const;
-    const std::vector<HeaderParamView>& params() const;
+    const HeaderParamViewList& params() const;
     bool hasParam(std::string_view name) const;
 
 private:
     std::string_view name_;
     std::string_view value_;
-    std::vector<HeaderParamView> params_;
+    HeaderParamViewList params_;
 };
 
+/// Parts after the header value become params, the ones without '=' are kept as flag params
 std::optional<HeaderView> headerFromString(std::string_view);
+ParseResult<HeaderView> headerFromString(std::string_view, const ParseLimits& limits);
 
 } //namespace http
 
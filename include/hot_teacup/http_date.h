@@ -0,0 +1,27 @@
+#ifndef HOT_TEACUP_HTTP_DATE_H
+#define HOT_TEACUP_HTTP_DATE_H
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace http {
+
+/// Formats the time as IMF-fixdate, e.g. "Sun, 06 Nov 1994 08:49:37 GMT".
+/// Years outside of the 0-9999 range can't be represented in this format,
+/// such times are clamped to "Sat, 01 Jan 0000 00:00:00 GMT" and "Fri, 31 Dec 9999 23:59:59 GMT".
+std::string httpDateToString(std::chrono::system_clock::time_point time);
+
+/// Returns the current time formatted as IMF-fixdate.
+/// The string is cached by the calling thread and reformatted only when the second changes,
+/// the returned view stays valid until the next call in the same thread.
+std::string_view currentHttpDate();
+
+/// Parses a date in the IMF-fixdate format, obsolete HTTP date formats aren't supported.
+/// Dates with a day name that doesn't match the date and dates out of the system_clock range are rejected.
+std::optional<std::chrono::system_clock::time_point> httpDateFromString(std::string_view date);
+
+} //namespace http
+
+#endif //HOT_TEACUP_HTTP_DATE_H
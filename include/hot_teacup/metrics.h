@@ -0,0 +1,59 @@
+#ifndef HOT_TEACUP_METRICS_H
+#define HOT_TEACUP_METRICS_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace http {
+
+/// Metrics are collected only when the library is built with HOT_TEACUP_ENABLE_METRICS,
+/// otherwise the instrumentation compiles to nothing and all counters stay at zero.
+/// Allocation counting is performed by replacing the global operator new and operator delete,
+/// so an application providing its own replacements shouldn't enable the metrics.
+enum class MetricsOperation {
+    RequestViewParsing,
+    FormParsing,
+    ResponseParsing,
+    ResponseSerialization
+};
+
+struct OperationMetrics {
+    std::uint64_t callCount = 0;
+    std::uint64_t allocationCount = 0;
+    std::uint64_t allocatedBytes = 0;
+    std::uint64_t processedBytes = 0;
+    std::uint64_t elementCount = 0;
+    std::chrono::nanoseconds duration = {};
+};
+
+struct Metrics {
+    OperationMetrics requestViewParsing;
+    OperationMetrics formParsing;
+    OperationMetrics responseParsing;
+    OperationMetrics responseSerialization;
+};
+
+using MetricsCallback = std::function<void(MetricsOperation, const OperationMetrics&)>;
+
+constexpr bool metricsEnabled()
+{
+#ifdef HOT_TEACUP_ENABLE_METRICS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/// Returns metrics accumulated by the calling thread
+const Metrics& threadMetrics();
+void resetThreadMetrics();
+
+/// Sets a callback invoked with metrics of every instrumented call.
+/// It must be set before the library is used from multiple threads.
+/// The callback is invoked when the measured call finishes, exceptions thrown from it are caught and ignored.
+void setMetricsCallback(MetricsCallback callback);
+
+} //namespace http
+
+#endif //HOT_TEACUP_METRICS_H
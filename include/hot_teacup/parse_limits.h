@@ -0,0 +1,24 @@
+#ifndef HOT_TEACUP_PARSE_LIMITS_H
+#define HOT_TEACUP_PARSE_LIMITS_H
+
+#include <cstddef>
+#include <limits>
+
+namespace http {
+
+/// Bounds the work a parser can be made to do by its input.
+/// Parsing stops as soon as any of the limits is exceeded.
+struct ParseLimits {
+    /// Maximum number of query, cookie, form, header or header param entries, separators of empty entries included
+    std::size_t maxFieldCount = std::numeric_limits<std::size_t>::max();
+    /// Maximum number of multipart form parts
+    std::size_t maxPartCount = std::numeric_limits<std::size_t>::max();
+    /// Maximum length of a response or multipart part header line
+    std::size_t maxHeaderLineLength = std::numeric_limits<std::size_t>::max();
+    /// Maximum size of the parsed input
+    std::size_t maxTotalSize = std::numeric_limits<std::size_t>::max();
+};
+
+} //namespace http
+
+#endif //HOT_TEACUP_PARSE_LIMITS_H
@@ -0,0 +1,115 @@
+#ifndef HOT_TEACUP_PARSE_RESULT_H
+#define HOT_TEACUP_PARSE_RESULT_H
+
+#include <cstddef>
+#include <utility>
+#include <variant>
+
+namespace http {
+
+enum class ParseErrorCode {
+    LimitExceeded,
+    InvalidHeader,
+    InvalidStatusLine,
+    MissingFormBoundary,
+    InvalidMultipartForm,
+    TruncatedMultipartForm
+};
+
+/// Input that ParseError::offset refers to: the string passed to the parsing function,
+/// or one of the RequestView inputs
+enum class ParseErrorSource {
+    Input,
+    QueryString,
+    Cookies,
+    Form
+};
+
+struct ParseError {
+    ParseErrorCode code;
+    /// Position in the parsed input where the error was detected
+    std::size_t offset = 0;
+    ParseErrorSource source = ParseErrorSource::Input;
+
+    friend bool operator==(const ParseError& lhs, const ParseError& rhs)
+    {
+        return lhs.code == rhs.code && lhs.offset == rhs.offset && lhs.source == rhs.source;
+    }
+};
+
+/// Holds either a parsed value or an error, accessing the missing value throws std::bad_variant_access
+template<typename T, typename TError = ParseError>
+class ParseResult {
+public:
+    ParseResult(T value)
+        : data_{std::in_place_index<0>, std::move(value)}
+    {
+    }
+
+    ParseResult(TError error)
+        : data_{std::in_place_index<1>, std::move(error)}
+    {
+    }
+
+    bool hasValue() const
+    {
+        return data_.index() == 0;
+    }
+
+    explicit operator bool() const
+    {
+        return hasValue();
+    }
+
+    const T& value() const&
+    {
+        return std::get<0>(data_);
+    }
+
+    T& value() &
+    {
+        return std::get<0>(data_);
+    }
+
+    T&& value() &&
+    {
+        return std::get<0>(std::move(data_));
+    }
+
+    const T& operator*() const&
+    {
+        return value();
+    }
+
+    T& operator*() &
+    {
+        return value();
+    }
+
+    T&& operator*() &&
+    {
+        return std::move(*this).value();
+    }
+
+    const T* operator->() const
+    {
+        return &value();
+    }
+
+    T* operator->()
+    {
+        return &value();
+    }
+
+    const TError& error() const
+    {
+        return std::get<1>(data_);
+    }
+
+private:
+    std::variant<T, TError> data_;
+};
+
+} //namespace http
+
+#endif //HOT_TEACUP_PARSE_RESULT_H
@@ -1,7 +1,10 @@
 #ifndef HOT_TEACUP_QUERY_VIEW_H
 #define HOT_TEACUP_QUERY_VIEW_H
 
+#include "parse_limits.h"
+#include "parse_result.h"
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace http {
@@ -19,6 +22,7 @@ private:
 };
 
 std::vector<QueryView> queriesFromString(std::string_view input);
+ParseResult<std::vector<QueryView>> queriesFromString(std::string_view input, const ParseLimits& limits);
 } //namespace http
 
 #endif //HOT_TEACUP_QUERY_VIEW_H
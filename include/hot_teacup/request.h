@@ -19,6 +19,7 @@ struct RequestFcgiData {
 class Request {
 public:
     explicit Request(const RequestView&);
+    Request(const RequestView&, const FormFileSpooling&);
     Request(RequestMethod, std::string path, std::vector<Query> = {}, std::vector<Cookie> = {}, Form = {});
 
     RequestMethod method() const;
@@ -44,14 +45,16 @@ public:
     bool hasFile(std::string_view name) const;
     const std::string& fileName(std::string_view name, int index = 0) const;
     const std::string& fileType(std::string_view name, int index = 0) const;
+    const std::filesystem::path& filePath(std::string_view name, int index = 0) const;
     bool hasFiles() const;
 
     RequestFcgiData toFcgiData(FormType) const;
 
-    void setQueries(const std::vector<Query>&);
-    void setCookies(const std::vector<Cookie>&);
-    void setForm(const Form&);
-    void setFcgiParams(const std::map<std::string, std::string>& params);
+    void setQueries(std::vector<Query>);
+    void setCookies(std::vector<Cookie>);
+    void setForm(Form);
+    void setFcgiParams(std::map<std::string, std::string> params);
+    Form takeForm();
 
 private:
     RequestMethod method_;
@@ -63,6 +66,7 @@ private:
 
 private:
     static inline const std::string valueNotFound = {};
+    static inline const std::filesystem::path pathNotFound = {};
 };
 
 } //namespace http
@@ -0,0 +1,40 @@
+#ifndef HOT_TEACUP_REQUEST_BATCH_H
+#define HOT_TEACUP_REQUEST_BATCH_H
+
+#include "request_view.h"
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace http {
+
+/// Raw FastCGI data of a single request, in the order of RequestView constructor parameters
+struct RequestRecord {
+    std::string_view fcgiParamRequestMethod;
+    std::string_view fcgiParamRemoteAddr;
+    std::string_view fcgiParamHttpHost;
+    std::string_view fcgiParamRequestUri;
+    std::string_view fcgiParamQueryString;
+    std::string_view fcgiParamHttpCookie;
+    std::string_view fcgiParamContentType;
+    std::string_view fcgiStdIn;
+};
+
+using RequestVisitor = std::function<void(std::size_t recordIndex, const RequestView& request)>;
+
+/// Parses the records on a pool of threadCount threads (hardware concurrency if 0)
+/// and passes every parsed request to the visitor, which can be invoked concurrently.
+/// Records are handed out to threads in chunks, so a thread that finishes early picks up the remaining work.
+/// The first exception thrown by the visitor stops the processing and is rethrown to the caller.
+void visitRequests(
+        const std::vector<RequestRecord>& records,
+        const RequestVisitor& visitor,
+        std::size_t threadCount = 0);
+
+/// Parses the records in parallel, returned requests are in the same order as the records
+std::vector<RequestView> parseRequests(const std::vector<RequestRecord>& records, std::size_t threadCount = 0);
+
+} //namespace http
+
+#endif //HOT_TEACUP_REQUEST_BATCH_H
@@ -0,0 +1,260 @@
+#ifndef HOT_TEACUP_REQUEST_FIELDS_H
+#define HOT_TEACUP_REQUEST_FIELDS_H
+
+#include "parse_result.h"
+#include "request_view.h"
+#include "types.h"
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace http {
+
+enum class FieldSource {
+    Query,
+    Form
+};
+
+enum class FieldErrorCode {
+    Missing,
+    InvalidValue
+};
+
+struct FieldError {
+    std::string_view name;
+    FieldSource source;
+    FieldErrorCode code;
+
+    friend bool operator==(const FieldError& lhs, const FieldError& rhs)
+    {
+        return lhs.name == rhs.name && lhs.source == rhs.source && lhs.code == rhs.code;
+    }
+};
+
+/// Converts field values to T, specialize it to extract other types, e.g. enums:
+/// template<> struct http::FieldConverter<Color> { static std::optional<Color> fromString(std::string_view); };
+template<typename T, typename = void>
+struct FieldConverter;
+
+namespace detail {
+/// Fallback for standard libraries without floating-point std::from_chars (libstdc++ before GCC 11, older libc++).
+/// The value is checked to have the from_chars syntax, strtod is locale dependent and expects '.' as the separator
+/// in the C locale.
+template<typename T>
+std::optional<T> floatingPointFromString(std::string_view value)
+{
+    if (value.empty() || value.front() == '+' || std::isspace(static_cast<unsigned char>(value.front())) ||
+        value.find_first_of("xX") != std::string_view::npos)
+        return std::nullopt;
+
+    const auto str = std::string{value};
+    auto end = static_cast<char*>(nullptr);
+    errno = 0;
+    auto result = T{};
+    if constexpr (std::is_same_v<T, float>)
+        result = std::strtof(str.c_str(), &end);
+    else if constexpr (std::is_same_v<T, double>)
+        result = std::strtod(str.c_str(), &end);
+    else
+        result = std::strtold(str.c_str(), &end);
+    if (errno == ERANGE || end != str.c_str() + str.size())
+        return std::nullopt;
+    return result;
+}
+} //namespace detail
+
+template<typename T>
+struct FieldConverter<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>> {
+    static std::optional<T> fromString(std::string_view value)
+    {
+        auto result = T{};
+        const auto valueEnd = value.data() + value.size();
+        const auto [end, error] = std::from_chars(value.data(), valueEnd, result);
+        if (error != std::errc{} || end != valueEnd)
+            return std::nullopt;
+        return result;
+    }
+};
+
+template<typename T>
+struct FieldConverter<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    static std::optional<T> fromString(std::string_view value)
+    {
+#ifdef __cpp_lib_to_chars
+        auto result = T{};
+        const auto valueEnd = value.data() + value.size();
+        const auto [end, error] = std::from_chars(value.data(), valueEnd, result);
+        if (error != std::errc{} || end != valueEnd)
+            return std::nullopt;
+        return result;
+#else
+        return detail::floatingPointFromString<T>(value);
+#endif
+    }
+};
+
+template<>
+struct FieldConverter<bool> {
+    static std::optional<bool> fromString(std::string_view value)
+    {
+        if (value == "true" || value == "1")
+            return true;
+        if (value == "false" || value == "0")
+            return false;
+        return std::nullopt;
+    }
+};
+
+template<>
+struct FieldConverter<std::string_view> {
+    static std::optional<std::string_view> fromString(std::string_view value)
+    {
+        return value;
+    }
+};
+
+template<>
+struct FieldConverter<std::string> {
+    static std::optional<std::string> fromString(std::string_view value)
+    {
+        return std::string{value};
+    }
+};
+
+template<typename TStruct, typename TMember>
+struct FieldSpec {
+    FieldSource source;
+    std::string_view name;
+    TMember TStruct::*member;
+};
+
+/// Fields stored in std::optional members are optional, others are reported as missing
+template<typename TStruct, typename TMember>
+constexpr FieldSpec<TStruct, TMember> fromQuery(std::string_view name, TMember TStruct::*member)
+{
+    return {FieldSource::Query, name, member};
+}
+
+template<typename TStruct, typename TMember>
+constexpr FieldSpec<TStruct, TMember> fromForm(std::string_view name, TMember TStruct::*member)
+{
+    return {FieldSource::Form, name, member};
+}
+
+/// Holds either the extracted fields or the errors of all missing and invalid ones
+template<typename T>
+using FieldsResult = ParseResult<T, std::vector<FieldError>>;
+
+namespace detail {
+template<typename T>
+struct FieldValueType {
+    using type = T;
+    static constexpr bool isOptional = false;
+};
+
+template<typename T>
+struct FieldValueType<std::optional<T>> {
+    using type = T;
+    static constexpr bool isOptional = true;
+};
+} //namespace detail
+
+/// Describes how to fill the default constructible struct TStruct from the request queries and form fields:
+///     constexpr auto schema = http::FieldSchema{http::fromQuery("page", &Params::page),
+///                                               http::fromForm("name", &Params::name)};
+/// Each container is traversed once and every entry is compared with the names of the schema fields,
+/// so the cost grows with the number of entries times the number of fields.
+/// Values are converted with FieldConverter without throwing exceptions.
+/// When a field is repeated, the first value is used. std::string_view members refer to the request data.
+template<typename TStruct, typename... TMembers>
+class FieldSchema {
+public:
+    constexpr explicit FieldSchema(FieldSpec<TStruct, TMembers>... fields)
+        : fields_{fields...}
+    {
+    }
+
+    FieldsResult<TStruct> extract(const RequestView& request) const
+    {
+        auto state = ExtractionState{};
+        for (const auto& query : request.queries())
+            readValue(FieldSource::Query, query.name(), query.value(), state, std::index_sequence_for<TMembers...>{});
+        for (const auto& [name, field] : request.form())
+            if (field.type() == FormFieldType::Param)
+                readValue(FieldSource::Form, name, field.value(), state, std::index_sequence_for<TMembers...>{});
+
+        checkMissingValues(state, std::index_sequence_for<TMembers...>{});
+        if (!state.errors.empty())
+            return std::move(state.errors);
+        return std::move(state.result);
+    }
+
+private:
+    struct ExtractionState {
+        TStruct result = {};
+        std::array<bool, sizeof...(TMembers)> isFound = {};
+        std::vector<FieldError> errors;
+    };
+
+    template<std::size_t... Is>
+    void readValue(
+            FieldSource source,
+            std::string_view name,
+            std::string_view value,
+            ExtractionState& state,
+            std::index_sequence<Is...>) const
+    {
+        (readFieldValue(std::get<Is>(fields_), source, name, value, state.isFound[Is], state), ...);
+    }
+
+    template<typename TMember>
+    static void readFieldValue(
+            const FieldSpec<TStruct, TMember>& field,
+            FieldSource source,
+            std::string_view name,
+            std::string_view value,
+            bool& isFound,
+            ExtractionState& state)
+    {
+        if (isFound || field.source != source || field.name != name)
+            return;
+        isFound = true;
+
+        auto fieldValue = FieldConverter<typename detail::FieldValueType<TMember>::type>::fromString(value);
+        if (!fieldValue) {
+            state.errors.push_back({field.name, field.source, FieldErrorCode::InvalidValue});
+            return;
+        }
+        state.result.*field.member = std::move(*fieldValue);
+    }
+
+    template<std::size_t... Is>
+    void checkMissingValues(ExtractionState& state, std::index_sequence<Is...>) const
+    {
+        (checkMissingValue(std::get<Is>(fields_), state.isFound[Is], state), ...);
+    }
+
+    template<typename TMember>
+    static void checkMissingValue(const FieldSpec<TStruct, TMember>& field, bool isFound, ExtractionState& state)
+    {
+        if (!isFound && !detail::FieldValueType<TMember>::isOptional)
+            state.errors.push_back({field.name, field.source, FieldErrorCode::Missing});
+    }
+
+private:
+    std::tuple<FieldSpec<TStruct, TMembers>...> fields_;
+};
+
+} //namespace http
+
+#endif //HOT_TEACUP_REQUEST_FIELDS_H
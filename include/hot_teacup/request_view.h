@@ -4,11 +4,16 @@
 #include "cookie_view.h"
 #include "form_view.h"
 #include "query_view.h"
+#include "shared_buffer.h"
 #include "types.h"
 #include <map>
+#include <optional>
 #include <string>
 
 namespace http {
+namespace detail {
+class MetricsScope;
+}
 
 class RequestView {
 public:
@@ -21,6 +26,19 @@ public:
             std::string_view fcgiParamHttpCookie,
             std::string_view fcgiParamContentType,
             std::string_view fcgiStdIn);
+    /// Parsing stops on the first error or exceeded limit, queries, cookies and form are left empty
+    /// and parseError() returns the error with the offset in the input that caused it,
+    /// ParseError::source tells whether the offset is in the query string, the cookie header or the form body
+    RequestView(
+            std::string_view fcgiParamRequestMethod,
+            std::string_view fcgiParamRemoteAddr,
+            std::string_view fcgiParamHttpHost,
+            std::string_view fcgiParamRequestUri,
+            std::string_view fcgiParamQueryString,
+            std::string_view fcgiParamHttpCookie,
+            std::string_view fcgiParamContentType,
+            std::string_view fcgiStdIn,
+            const ParseLimits& limits);
 
     RequestMethod method() const;
     std::string_view ipAddress() const;
@@ -49,6 +67,21 @@ public:
     std::string_view fileType(std::string_view name, int index = 0) const;
     bool hasFiles() const;
 
+    const std::optional<ParseError>& parseError() const;
+
+private:
+    /// Delegating target keeping the metrics scope alive while the members are initialized
+    RequestView(
+            detail::MetricsScope&& metrics,
+            std::string_view fcgiParamRequestMethod,
+            std::string_view fcgiParamRemoteAddr,
+            std::string_view fcgiParamHttpHost,
+            std::string_view fcgiParamRequestUri,
+            std::string_view fcgiParamQueryString,
+            std::string_view fcgiParamHttpCookie,
+            std::string_view fcgiParamContentType,
+            std::string_view fcgiStdIn);
+
 private:
     RequestMethod method_;
     std::string_view ipAddress_;
@@ -57,6 +90,23 @@ private:
     std::vector<QueryView> queries_;
     std::vector<CookieView> cookies_;
     FormView form_;
+    std::optional<ParseError> parseError_;
+};
+
+/// RequestView that owns its data: the input is copied once into a buffer shared between the object copies,
+/// so it can outlive the original FastCGI request data without converting every field to std::string.
+class SharedRequestView : private detail::SharedBuffer,
+                          public RequestView {
+public:
+    SharedRequestView(
+            std::string_view fcgiParamRequestMethod,
+            std::string_view fcgiParamRemoteAddr,
+            std::string_view fcgiParamHttpHost,
+            std::string_view fcgiParamRequestUri,
+            std::string_view fcgiParamQueryString,
+            std::string_view fcgiParamHttpCookie,
+            std::string_view fcgiParamContentType,
+            std::string_view fcgiStdIn);
 };
 
 } //namespace http
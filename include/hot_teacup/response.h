@@ -5,7 +5,10 @@
 #include "header.h"
 #include "query.h"
 #include "types.h"
+#include <bitset>
+#include <optional>
 #include <string>
+#include <string_view>
 
 namespace http {
 class ResponseView;
@@ -15,6 +18,22 @@ struct Redirect {
     RedirectType type = RedirectType::Found;
 };
 
+/// Headers generated during the serialization, they aren't added if the response already contains them
+struct ResponseDataOptions {
+    /// Content-Length is computed from the body and omitted for 1xx, 204 and 304 responses
+    bool contentLength = true;
+    /// Date is the current time, formatted once per second and thread
+    bool date = false;
+    /// Encoding of the body, usually chosen with negotiateContentEncoding() from the request's Accept-Encoding.
+    /// Bodies smaller than compressionThreshold and responses with Content-Encoding or Content-Length already set
+    /// are sent as is, otherwise the body is compressed and Content-Encoding header is added. Accept-Encoding
+    /// is appended to the existing Vary header unless it's already listed there, or a new Vary header is added.
+    /// The encoding is ignored when the library is built without compression support.
+    ContentEncoding contentEncoding = ContentEncoding::Identity;
+    std::size_t compressionThreshold = 1024;
+    int compressionLevel = -1;
+};
+
 class Response {
 public:
     explicit Response(const ResponseView&);
@@ -54,23 +73,44 @@ public:
     const std::vector<Cookie>& cookies() const;
     const std::vector<Header>& headers() const;
     std::string data(ResponseMode mode = ResponseMode::Http) const;
+    std::string data(ResponseMode mode, const ResponseDataOptions& options) const;
 
-    void setBody(const std::string& body);
+    void setBody(std::string body);
+    std::string takeBody();
     void addCookie(Cookie cookie);
     void addHeader(Header header);
-    void addCookies(const std::vector<Cookie>& cookies);
-    void addHeaders(const std::vector<Header>& headers);
+    void addCookies(std::vector<Cookie> cookies);
+    void addHeaders(std::vector<Header> headers);
+    /// Replaces the headers with the same name or adds the header if there are none. Names are case-insensitive.
+    void setHeader(Header header);
+    void removeHeader(std::string_view name);
+    /// Returns the first header with the name or nullptr if it's missing
+    const Header* findHeader(std::string_view name) const;
 
 private:
+    Response(
+            ResponseStatus status,
+            std::string body,
+            std::vector<Cookie> cookies,
+            std::vector<Header> headers,
+            std::optional<std::string> contentType);
     std::string statusData(ResponseMode mode) const;
-    std::string cookiesData() const;
-    std::string headersData() const;
+    void appendCookiesData(std::string& result) const;
+    void appendHeadersData(std::string& result, std::optional<std::size_t> acceptEncodingVaryIndex) const;
+    void trackHeader(const Header& header);
+    bool hasHeader(KnownHeader header) const;
+    bool varyListsAcceptEncoding() const;
+    std::optional<std::size_t> findHeaderIndex(std::string_view name, std::size_t firstIndex = 0) const;
+    void eraseHeaders(std::string_view name, std::size_t firstIndex);
 
 private:
     ResponseStatus status_ = ResponseStatus::_404_Not_Found;
     std::string body_;
     std::vector<Cookie> cookies_;
     std::vector<Header> headers_;
+    /// Presence of the well-known headers used during construction and serialization:
+    /// Content-Type, Location, Content-Length, Date and Content-Encoding
+    std::bitset<5> knownHeaders_;
 };
 
 } //namespace http
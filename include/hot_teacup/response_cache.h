@@ -0,0 +1,68 @@
+#ifndef HOT_TEACUP_RESPONSE_CACHE_H
+#define HOT_TEACUP_RESPONSE_CACHE_H
+
+#include "types.h"
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace http {
+class RequestView;
+class Response;
+
+struct ResponseCacheOptions {
+    std::chrono::steady_clock::duration timeToLive = std::chrono::seconds{60};
+    std::size_t maxEntryCount = 1024;
+    /// Total size of the cached keys and response data in bytes
+    std::size_t maxTotalSize = 64 * 1024 * 1024;
+    /// Number of independently locked parts of the cache, the size limits are split evenly between them
+    std::size_t stripeCount = 16;
+};
+
+namespace detail {
+struct ResponseCacheStripe;
+}
+
+/// Thread-safe cache of serialized responses.
+/// Lookups of different keys mostly lock different stripes, and lookups of the same stripe share its lock.
+/// When a stripe is full, its oldest entries are evicted first.
+class ResponseCache {
+public:
+    explicit ResponseCache(ResponseCacheOptions options = {});
+    ~ResponseCache();
+    ResponseCache(const ResponseCache&) = delete;
+    ResponseCache& operator=(const ResponseCache&) = delete;
+
+    /// Returns the cached data or nullptr if it's missing or expired
+    std::shared_ptr<const std::string> find(std::string_view key, ResponseMode mode = ResponseMode::Http) const;
+    /// Stores the data and returns it, data exceeding the size limit of a stripe isn't cached
+    std::shared_ptr<const std::string> store(
+            std::string_view key,
+            std::string responseData,
+            ResponseMode mode = ResponseMode::Http);
+    std::shared_ptr<const std::string> store(
+            std::string_view key,
+            const Response& response,
+            ResponseMode mode = ResponseMode::Http);
+    void remove(std::string_view key);
+    void clear();
+    /// Returns the number of stored entries, including the expired ones that weren't evicted yet
+    std::size_t size() const;
+
+private:
+    detail::ResponseCacheStripe& stripe(std::string_view key) const;
+
+private:
+    ResponseCacheOptions options_;
+    std::vector<std::unique_ptr<detail::ResponseCacheStripe>> stripes_;
+};
+
+/// Makes a cache key from the request path and the values of the listed queries
+std::string responseCacheKey(const RequestView& request, const std::vector<std::string_view>& queryNames = {});
+
+} //namespace http
+
+#endif //HOT_TEACUP_RESPONSE_CACHE_H
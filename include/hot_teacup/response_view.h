@@ -3,11 +3,16 @@
 
 #include "cookie_view.h"
 #include "header_view.h"
+#include "parse_limits.h"
+#include "parse_result.h"
+#include "shared_buffer.h"
 #include "types.h"
 #include <string>
+#include <type_traits>
 
 namespace http {
 
+/// Non-owning view of a response: the body, like every other field, must outlive the object.
 class ResponseView {
 public:
     ResponseView(
@@ -15,6 +20,13 @@ public:
             std::string_view body = {},
             std::vector<CookieView> cookies = {},
             std::vector<HeaderView> headers = {});
+    //a temporary body would dangle, use Response or SharedResponseView to own it
+    template<typename TString, std::enable_if_t<std::is_same_v<TString, std::string>>* = nullptr>
+    ResponseView(
+            ResponseStatus status,
+            TString&& body,
+            std::vector<CookieView> cookies = {},
+            std::vector<HeaderView> headers = {}) = delete;
 
     ResponseStatus status() const;
     std::string_view body() const;
@@ -23,12 +35,23 @@ public:
 
 private:
     ResponseStatus status_ = ResponseStatus::_404_Not_Found;
-    std::string body_;
+    std::string_view body_;
     std::vector<CookieView> cookies_;
     std::vector<HeaderView> headers_;
 };
 
+/// ResponseView that owns its data: the input is copied once into a buffer shared between the object copies.
+class SharedResponseView : private detail::SharedBuffer,
+                           public ResponseView {
+    SharedResponseView(std::shared_ptr<const std::string> buffer, ResponseView responseView);
+    friend std::optional<SharedResponseView> sharedResponseFromString(std::string_view, ResponseMode);
+};
+
 std::optional<ResponseView> responseFromString(std::string_view, ResponseMode mode = ResponseMode::Http);
+ParseResult<ResponseView> responseFromString(std::string_view, ResponseMode mode, const ParseLimits& limits);
+std::optional<SharedResponseView> sharedResponseFromString(
+        std::string_view,
+        ResponseMode mode = ResponseMode::Http);
 
 } //namespace http
 
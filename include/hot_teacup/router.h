@@ -0,0 +1,77 @@
+#ifndef HOT_TEACUP_ROUTER_H
+#define HOT_TEACUP_ROUTER_H
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace http {
+class RequestView;
+
+/// Result of a successful Router::match() call, refers to the matched path and to the router's route data,
+/// so it must not outlive them
+class RouteMatch {
+public:
+    static constexpr std::size_t maxParamCount = 8;
+
+    std::size_t routeId() const;
+    /// Returns the value of the {name} segment or an empty string if the route doesn't have it
+    std::string_view param(std::string_view name) const;
+    /// Returns the value of the parameter at the index in the order of pattern segments
+    std::string_view param(std::size_t index) const;
+    std::size_t paramCount() const;
+    /// Returns the part of the path matched by the trailing wildcard
+    std::string_view wildcard() const;
+
+private:
+    RouteMatch() = default;
+    friend class Router;
+
+private:
+    std::size_t routeId_ = 0;
+    const std::vector<std::string>* paramNames_ = nullptr;
+    std::array<std::string_view, maxParamCount> paramValues_;
+    std::string_view wildcard_;
+};
+
+/// Matches paths against patterns made of '/'-separated segments: literals, {name} parameters matching
+/// any non-empty segment, and a trailing * matching the rest of the path.
+/// Patterns are stored in a tree of segments, so a match visits only the branches sharing the path's prefix.
+/// Literal segments take precedence over parameters, and parameters over the wildcard.
+class Router {
+public:
+    Router();
+    /// Adds the pattern and returns its id, ids are assigned sequentially starting from zero.
+    /// Throws std::invalid_argument if the pattern is malformed or was already added.
+    std::size_t addRoute(std::string_view pattern);
+    std::optional<RouteMatch> match(std::string_view path) const;
+    std::optional<RouteMatch> match(const RequestView& request) const;
+
+private:
+    struct Node {
+        /// Sorted by the segment
+        std::vector<std::pair<std::string, std::size_t>> literalChildren;
+        std::optional<std::size_t> paramChild;
+        std::optional<std::size_t> routeId;
+        std::optional<std::size_t> wildcardRouteId;
+    };
+    bool matchSegments(
+            const Node& node,
+            std::optional<std::string_view> path,
+            RouteMatch& result,
+            std::size_t paramCount) const;
+    std::size_t literalChild(std::size_t nodeIndex, std::string_view segment);
+    std::size_t paramChild(std::size_t nodeIndex);
+
+private:
+    std::vector<Node> nodes_;
+    std::vector<std::vector<std::string>> routeParamNames_;
+};
+
+} //namespace http
+
+#endif //HOT_TEACUP_ROUTER_H
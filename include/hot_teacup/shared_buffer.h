@@ -0,0 +1,49 @@
+#ifndef HOT_TEACUP_SHARED_BUFFER_H
+#define HOT_TEACUP_SHARED_BUFFER_H
+
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace http::detail {
+
+/// Holds a single immutable copy of the parsed input, shared between copies of the owning views
+class SharedBuffer {
+public:
+    explicit SharedBuffer(std::shared_ptr<const std::string> buffer)
+        : buffer_{std::move(buffer)}
+    {
+    }
+
+    explicit SharedBuffer(std::initializer_list<std::string_view> parts)
+        : buffer_{makeBuffer(parts)}
+    {
+    }
+
+    std::string_view sharedBuffer() const
+    {
+        return *buffer_;
+    }
+
+private:
+    static std::shared_ptr<const std::string> makeBuffer(std::initializer_list<std::string_view> parts)
+    {
+        auto size = std::size_t{};
+        for (auto part : parts)
+            size += part.size();
+        auto buffer = std::make_shared<std::string>();
+        buffer->reserve(size);
+        for (auto part : parts)
+            buffer->append(part);
+        return buffer;
+    }
+
+private:
+    std::shared_ptr<const std::string> buffer_;
+};
+
+} //namespace http::detail
+
+#endif //HOT_TEACUP_SHARED_BUFFER_H
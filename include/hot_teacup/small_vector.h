@@ -0,0 +1,347 @@
+#ifndef HOT_TEACUP_SMALL_VECTOR_H
+#define HOT_TEACUP_SMALL_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace http {
+
+/// Vector storing up to N elements inside the object, larger sizes move the elements to the heap.
+/// It provides the std::vector element access, iteration and comparison, but only emplace_back, push_back,
+/// reserve and clear as modifiers. Conversions from and to std::vector copy the elements, so they're explicit.
+/// The inline elements make the object large and its move linear in the size, so it's meant for members
+/// of small types that are rarely moved, not for nesting inside other inline storage.
+template<typename T, std::size_t N>
+class SmallVector {
+    static_assert(N > 0);
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    SmallVector() = default;
+
+    //the constructors delegate to the default one, so the destructor releases the elements if a copy throws
+    explicit SmallVector(const std::vector<T>& items)
+        : SmallVector{}
+    {
+        reserve(items.size());
+        for (const auto& item : items)
+            emplace_back(item);
+    }
+
+    SmallVector(std::initializer_list<T> items)
+        : SmallVector{}
+    {
+        reserve(items.size());
+        for (const auto& item : items)
+            emplace_back(item);
+    }
+
+    SmallVector(const SmallVector& other)
+        : SmallVector{}
+    {
+        reserve(other.size_);
+        for (const auto& item : other)
+            emplace_back(item);
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        takeItems(other);
+    }
+
+    SmallVector& operator=(const SmallVector& other)
+    {
+        if (this == &other)
+            return *this;
+        clear();
+        reserve(other.size_);
+        for (const auto& item : other)
+            emplace_back(item);
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this == &other)
+            return *this;
+        clear();
+        releaseHeapStorage();
+        takeItems(other);
+        return *this;
+    }
+
+    ~SmallVector()
+    {
+        clear();
+        releaseHeapStorage();
+    }
+
+    explicit operator std::vector<T>() const
+    {
+        return std::vector<T>(begin(), end());
+    }
+
+    template<typename... TArgs>
+    T& emplace_back(TArgs&&... args)
+    {
+        if (size_ < capacity_)
+            return *new (data_ + size_++) T(std::forward<TArgs>(args)...);
+
+        //the arguments can refer to the stored elements, so the new one is created before they're moved
+        auto item = T(std::forward<TArgs>(args)...);
+        reallocate(capacity_ * 2);
+        return *new (data_ + size_++) T(std::move(item));
+    }
+
+    void push_back(const T& item)
+    {
+        emplace_back(item);
+    }
+
+    void push_back(T&& item)
+    {
+        emplace_back(std::move(item));
+    }
+
+    void reserve(size_type capacity)
+    {
+        if (capacity > capacity_)
+            reallocate(capacity);
+    }
+
+    void clear()
+    {
+        std::destroy(begin(), end());
+        size_ = 0;
+    }
+
+    size_type size() const
+    {
+        return size_;
+    }
+
+    size_type capacity() const
+    {
+        return capacity_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    T* data()
+    {
+        return data_;
+    }
+
+    const T* data() const
+    {
+        return data_;
+    }
+
+    iterator begin()
+    {
+        return data_;
+    }
+
+    iterator end()
+    {
+        return data_ + size_;
+    }
+
+    const_iterator begin() const
+    {
+        return data_;
+    }
+
+    const_iterator end() const
+    {
+        return data_ + size_;
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    reverse_iterator rbegin()
+    {
+        return reverse_iterator{end()};
+    }
+
+    reverse_iterator rend()
+    {
+        return reverse_iterator{begin()};
+    }
+
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator{end()};
+    }
+
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator{begin()};
+    }
+
+    const_reverse_iterator crbegin() const
+    {
+        return rbegin();
+    }
+
+    const_reverse_iterator crend() const
+    {
+        return rend();
+    }
+
+    T& operator[](size_type index)
+    {
+        return data_[index];
+    }
+
+    const T& operator[](size_type index) const
+    {
+        return data_[index];
+    }
+
+    T& at(size_type index)
+    {
+        if (index >= size_)
+            throw std::out_of_range{"SmallVector index is out of range"};
+        return data_[index];
+    }
+
+    const T& at(size_type index) const
+    {
+        if (index >= size_)
+            throw std::out_of_range{"SmallVector index is out of range"};
+        return data_[index];
+    }
+
+    T& front()
+    {
+        return data_[0];
+    }
+
+    const T& front() const
+    {
+        return data_[0];
+    }
+
+    T& back()
+    {
+        return data_[size_ - 1];
+    }
+
+    const T& back() const
+    {
+        return data_[size_ - 1];
+    }
+
+    friend bool operator==(const SmallVector& lhs, const SmallVector& rhs)
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend bool operator!=(const SmallVector& lhs, const SmallVector& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    bool isInline() const
+    {
+        return data_ == inlineStorage_.items;
+    }
+
+    /// Like std::vector, the elements are copied if their move can throw, so they stay unchanged on exceptions
+    void reallocate(size_type capacity)
+    {
+        auto allocator = std::allocator<T>{};
+        auto data = allocator.allocate(capacity);
+        try {
+            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+                std::uninitialized_move(begin(), end(), data);
+            else
+                std::uninitialized_copy(begin(), end(), data);
+        }
+        catch (...) {
+            allocator.deallocate(data, capacity);
+            throw;
+        }
+        std::destroy(begin(), end());
+        releaseHeapStorage();
+        data_ = data;
+        capacity_ = capacity;
+    }
+
+    void releaseHeapStorage()
+    {
+        if (!isInline())
+            std::allocator<T>{}.deallocate(data_, capacity_);
+        data_ = inlineStorage_.items;
+        capacity_ = N;
+    }
+
+    /// Expects this vector to be empty and to use the inline storage
+    void takeItems(SmallVector& other)
+    {
+        if (other.isInline()) {
+            std::uninitialized_move(other.begin(), other.end(), data_);
+            size_ = other.size_;
+            other.clear();
+            return;
+        }
+        data_ = std::exchange(other.data_, other.inlineStorage_.items);
+        capacity_ = std::exchange(other.capacity_, N);
+        size_ = std::exchange(other.size_, 0);
+    }
+
+private:
+    /// Union members aren't constructed automatically, so the elements are created only when they're added
+    union InlineStorage {
+        InlineStorage()
+        {
+        }
+
+        ~InlineStorage()
+        {
+        }
+
+        T items[N];
+    };
+
+    InlineStorage inlineStorage_;
+    T* data_ = inlineStorage_.items;
+    size_type size_ = 0;
+    size_type capacity_ = N;
+};
+
+} //namespace http
+
+#endif //HOT_TEACUP_SMALL_VECTOR_H
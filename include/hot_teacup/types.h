@@ -1,7 +1,12 @@
 #ifndef HOT_TEACUP_TYPES_H
 #define HOT_TEACUP_TYPES_H
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
+#include <optional>
 #include <string_view>
 
 namespace http {
@@ -82,6 +87,12 @@ enum class ContentType {
     Json
 };
 
+enum class ContentEncoding {
+    Identity,
+    Gzip,
+    Deflate
+};
+
 enum class RedirectType {
     MovedPermanently,
     PermanentRedirect,
@@ -113,26 +124,50 @@ namespace detail {
 
 constexpr RequestMethod methodFromString(std::string_view typeStr)
 {
-    if (typeStr == "GET")
-        return RequestMethod::Get;
-    else if (typeStr == "HEAD")
-        return RequestMethod::Head;
-    else if (typeStr == "POST")
-        return RequestMethod::Post;
-    else if (typeStr == "PUT")
-        return RequestMethod::Put;
-    else if (typeStr == "DELETE")
-        return RequestMethod::Delete;
-    else if (typeStr == "CONNECT")
-        return RequestMethod::Connect;
-    else if (typeStr == "OPTIONS")
-        return RequestMethod::Options;
-    else if (typeStr == "TRACE")
-        return RequestMethod::Trace;
-    else if (typeStr == "PATCH")
-        return RequestMethod::Patch;
-    else
-        return {};
+    //dispatching on the length and the first character leaves at most one string comparison
+    using Method = RequestMethod;
+    auto methodIf = [typeStr](std::string_view methodStr, Method method)
+    {
+        return typeStr == methodStr ? method : Method{};
+    };
+
+    switch (typeStr.size()) {
+    case 3:
+        switch (typeStr.front()) {
+        case 'G':
+            return methodIf("GET", Method::Get);
+        case 'P':
+            return methodIf("PUT", Method::Put);
+        }
+        break;
+    case 4:
+        switch (typeStr.front()) {
+        case 'H':
+            return methodIf("HEAD", Method::Head);
+        case 'P':
+            return methodIf("POST", Method::Post);
+        }
+        break;
+    case 5:
+        switch (typeStr.front()) {
+        case 'T':
+            return methodIf("TRACE", Method::Trace);
+        case 'P':
+            return methodIf("PATCH", Method::Patch);
+        }
+        break;
+    case 6:
+        return methodIf("DELETE", Method::Delete);
+    case 7:
+        switch (typeStr.front()) {
+        case 'C':
+            return methodIf("CONNECT", Method::Connect);
+        case 'O':
+            return methodIf("OPTIONS", Method::Options);
+        }
+        break;
+    }
+    return {};
 }
 
 constexpr const char* methodToString(RequestMethod method)
@@ -160,6 +195,135 @@ constexpr const char* methodToString(RequestMethod method)
     detail::ensureNotReachable();
 }
 
+enum class KnownHeader {
+    AcceptEncoding,
+    CacheControl,
+    ContentDisposition,
+    ContentEncoding,
+    ContentLength,
+    ContentType,
+    Cookie,
+    Date,
+    Expires,
+    Host,
+    LastModified,
+    Location,
+    SetCookie,
+    Vary
+};
+
+constexpr const char* knownHeaderToString(KnownHeader header)
+{
+    switch (header) {
+    case KnownHeader::AcceptEncoding:
+        return "Accept-Encoding";
+    case KnownHeader::CacheControl:
+        return "Cache-Control";
+    case KnownHeader::ContentDisposition:
+        return "Content-Disposition";
+    case KnownHeader::ContentEncoding:
+        return "Content-Encoding";
+    case KnownHeader::ContentLength:
+        return "Content-Length";
+    case KnownHeader::ContentType:
+        return "Content-Type";
+    case KnownHeader::Cookie:
+        return "Cookie";
+    case KnownHeader::Date:
+        return "Date";
+    case KnownHeader::Expires:
+        return "Expires";
+    case KnownHeader::Host:
+        return "Host";
+    case KnownHeader::LastModified:
+        return "Last-Modified";
+    case KnownHeader::Location:
+        return "Location";
+    case KnownHeader::SetCookie:
+        return "Set-Cookie";
+    case KnownHeader::Vary:
+        return "Vary";
+    }
+    detail::ensureNotReachable();
+}
+
+namespace detail {
+constexpr char toLowerAscii(char ch)
+{
+    return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+}
+
+/// ASCII case-insensitive comparison. The loop has no data-dependent branches,
+/// which lets optimizing compilers vectorize it like an exact comparison.
+constexpr bool equalsCaseInsensitive(std::string_view lhs, std::string_view rhs)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+    auto difference = 0u;
+    for (auto i = std::size_t{}; i < lhs.size(); ++i) {
+        const auto lhsCh = static_cast<unsigned char>(lhs[i]);
+        const auto rhsCh = static_cast<unsigned char>(rhs[i]);
+        const auto lhsLower = lhsCh | ((static_cast<unsigned char>(lhsCh - 'A') < 26u) << 5u);
+        const auto rhsLower = rhsCh | ((static_cast<unsigned char>(rhsCh - 'A') < 26u) << 5u);
+        difference |= lhsLower ^ rhsLower;
+    }
+    return difference == 0;
+}
+} //namespace detail
+
+/// Case-insensitive lookup of the header names used by the library
+constexpr std::optional<KnownHeader> knownHeaderFromString(std::string_view name)
+{
+    //dispatching on the length and the first character leaves at most one string comparison
+    using Header = KnownHeader;
+    auto headerIf = [name](Header header) -> std::optional<Header>
+    {
+        if (detail::equalsCaseInsensitive(name, knownHeaderToString(header)))
+            return header;
+        return std::nullopt;
+    };
+
+    switch (name.size()) {
+    case 4:
+        switch (detail::toLowerAscii(name.front())) {
+        case 'd':
+            return headerIf(Header::Date);
+        case 'h':
+            return headerIf(Header::Host);
+        case 'v':
+            return headerIf(Header::Vary);
+        }
+        break;
+    case 6:
+        return headerIf(Header::Cookie);
+    case 7:
+        return headerIf(Header::Expires);
+    case 8:
+        return headerIf(Header::Location);
+    case 10:
+        return headerIf(Header::SetCookie);
+    case 12:
+        return headerIf(Header::ContentType);
+    case 13:
+        switch (detail::toLowerAscii(name.front())) {
+        case 'c':
+            return headerIf(Header::CacheControl);
+        case 'l':
+            return headerIf(Header::LastModified);
+        }
+        break;
+    case 14:
+        return headerIf(Header::ContentLength);
+    case 15:
+        return headerIf(Header::AcceptEncoding);
+    case 16:
+        return headerIf(Header::ContentEncoding);
+    case 19:
+        return headerIf(Header::ContentDisposition);
+    }
+    return std::nullopt;
+}
+
 enum class FormFieldType {
     Param,
     File
@@ -177,6 +341,12 @@ enum class HeaderQuotingMode {
     AllValues
 };
 
+enum class CookieSameSite : std::uint8_t {
+    Strict,
+    Lax,
+    None
+};
+
 namespace detail {
 constexpr ResponseStatus redirectTypeStatus(RedirectType redirectType)
 {
@@ -462,6 +632,102 @@ constexpr ResponseStatus statusFromCode(int statusCode)
     }
 }
 
+constexpr const char* sameSiteToString(CookieSameSite sameSite)
+{
+    switch (sameSite) {
+    case CookieSameSite::Strict:
+        return "Strict";
+    case CookieSameSite::Lax:
+        return "Lax";
+    case CookieSameSite::None:
+        return "None";
+    }
+    ensureNotReachable();
+}
+
+enum class CookieAttribute : std::uint8_t {
+    Domain,
+    Path,
+    MaxAge,
+    Expires,
+    Secure,
+    HttpOnly,
+    SameSite,
+    Partitioned
+};
+
+constexpr auto cookieAttributeCount = static_cast<std::size_t>(CookieAttribute::Partitioned) + 1;
+
+constexpr const char* cookieAttributeToString(CookieAttribute attribute)
+{
+    switch (attribute) {
+    case CookieAttribute::Domain:
+        return "Domain";
+    case CookieAttribute::Path:
+        return "Path";
+    case CookieAttribute::MaxAge:
+        return "Max-Age";
+    case CookieAttribute::Expires:
+        return "Expires";
+    case CookieAttribute::Secure:
+        return "Secure";
+    case CookieAttribute::HttpOnly:
+        return "HttpOnly";
+    case CookieAttribute::SameSite:
+        return "SameSite";
+    case CookieAttribute::Partitioned:
+        return "Partitioned";
+    }
+    ensureNotReachable();
+}
+
+/// Cookie attributes in the order they were first set, used to serialize them in the same order
+class CookieAttributeList {
+public:
+    void add(CookieAttribute attribute)
+    {
+        if (!contains(attribute))
+            attributes_[size_++] = attribute;
+    }
+
+    bool contains(CookieAttribute attribute) const
+    {
+        return std::find(begin(), end(), attribute) != end();
+    }
+
+    const CookieAttribute* begin() const
+    {
+        return attributes_.data();
+    }
+
+    const CookieAttribute* end() const
+    {
+        return attributes_.data() + size_;
+    }
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+private:
+    std::array<CookieAttribute, cookieAttributeCount> attributes_ = {};
+    std::uint8_t size_ = 0;
+};
+
+constexpr const char* contentEncodingToString(ContentEncoding encoding)
+{
+    switch (encoding) {
+    case ContentEncoding::Identity:
+        return "identity";
+    case ContentEncoding::Gzip:
+        return "gzip";
+    case ContentEncoding::Deflate:
+        return "deflate";
+    }
+    ensureNotReachable();
+}
+
 constexpr const char* contentTypeToString(ContentType type)
 {
     switch (type) {
@@ -0,0 +1,219 @@
+#include <hot_teacup/compression.h>
+#include <sfun/string_utils.h>
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#ifdef HOT_TEACUP_ENABLE_COMPRESSION
+#include <zlib.h>
+#endif
+
+namespace http {
+
+namespace detail {
+
+class DeflateStream {
+public:
+    DeflateStream(ContentEncoding encoding, int level)
+        : encoding_{encoding}
+        , level_{level}
+    {
+        if (encoding_ == ContentEncoding::Identity)
+            return;
+#ifdef HOT_TEACUP_ENABLE_COMPRESSION
+        //adding 16 to the window bits makes zlib write the gzip wrapper instead of the zlib one
+        const auto windowBits = encoding_ == ContentEncoding::Gzip ? 15 + 16 : 15;
+        if (deflateInit2(&stream_, level_, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            throw std::runtime_error{"Can't initialize the zlib stream"};
+#else
+        throw std::runtime_error{"hot_teacup is built without compression support"};
+#endif
+    }
+
+    ~DeflateStream()
+    {
+#ifdef HOT_TEACUP_ENABLE_COMPRESSION
+        if (encoding_ != ContentEncoding::Identity)
+            deflateEnd(&stream_);
+#endif
+    }
+
+    DeflateStream(const DeflateStream&) = delete;
+    DeflateStream& operator=(const DeflateStream&) = delete;
+
+    void reset(int level)
+    {
+        if (encoding_ == ContentEncoding::Identity)
+            return;
+#ifdef HOT_TEACUP_ENABLE_COMPRESSION
+        if (deflateReset(&stream_) != Z_OK)
+            throw std::runtime_error{"Can't reset the zlib stream"};
+        if (level != level_) {
+            if (deflateParams(&stream_, level, Z_DEFAULT_STRATEGY) != Z_OK)
+                throw std::runtime_error{"Can't set the zlib compression level"};
+            level_ = level;
+        }
+#else
+        static_cast<void>(level);
+#endif
+    }
+
+    void write(std::string_view data, bool finish, std::string& output)
+    {
+        if (encoding_ == ContentEncoding::Identity) {
+            output += data;
+            return;
+        }
+#ifdef HOT_TEACUP_ENABLE_COMPRESSION
+        constexpr auto maxChunkSize = std::size_t{std::numeric_limits<uInt>::max()};
+        stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+        auto remainingSize = data.size();
+        do {
+            const auto inputSize = std::min(remainingSize, maxChunkSize);
+            stream_.avail_in = static_cast<uInt>(inputSize);
+            remainingSize -= inputSize;
+            const auto flush = (finish && remainingSize == 0) ? Z_FINISH : Z_NO_FLUSH;
+
+            auto result = Z_OK;
+            do {
+                const auto outputSize = output.size();
+                const auto chunkSize = std::min(
+                        std::max(std::size_t{deflateBound(&stream_, stream_.avail_in)}, std::size_t{4096}),
+                        maxChunkSize);
+                output.resize(outputSize + chunkSize);
+                stream_.next_out = reinterpret_cast<Bytef*>(&output[outputSize]);
+                stream_.avail_out = static_cast<uInt>(chunkSize);
+                result = deflate(&stream_, flush);
+                output.resize(output.size() - stream_.avail_out);
+                if (result == Z_STREAM_ERROR)
+                    throw std::runtime_error{"Can't compress data with a finished zlib stream"};
+            } while (flush == Z_FINISH ? result != Z_STREAM_END : stream_.avail_out == 0);
+        } while (remainingSize > 0);
+#else
+        static_cast<void>(finish);
+#endif
+    }
+
+private:
+    ContentEncoding encoding_;
+    int level_;
+#ifdef HOT_TEACUP_ENABLE_COMPRESSION
+    z_stream stream_ = {};
+#endif
+};
+
+} //namespace detail
+
+namespace {
+/// Returns the qvalue in thousandths
+std::optional<int> qvalueFromString(std::string_view value)
+{
+    value = sfun::trim(value);
+    if (value.empty() || (value.front() != '0' && value.front() != '1'))
+        return std::nullopt;
+    auto result = (value.front() - '0') * 1000;
+    value.remove_prefix(1);
+    if (value.empty())
+        return result;
+    if (value.front() != '.' || value.size() > 4)
+        return std::nullopt;
+    value.remove_prefix(1);
+
+    auto scale = 100;
+    for (auto ch : value) {
+        if (ch < '0' || ch > '9')
+            return std::nullopt;
+        result += (ch - '0') * scale;
+        scale /= 10;
+    }
+    if (result > 1000)
+        return std::nullopt;
+    return result;
+}
+
+detail::DeflateStream& threadDeflateStream(ContentEncoding encoding, int level)
+{
+    thread_local auto gzipStream = std::unique_ptr<detail::DeflateStream>{};
+    thread_local auto deflateStream = std::unique_ptr<detail::DeflateStream>{};
+
+    auto& stream = encoding == ContentEncoding::Gzip ? gzipStream : deflateStream;
+    if (stream)
+        stream->reset(level);
+    else
+        stream = std::make_unique<detail::DeflateStream>(encoding, level);
+    return *stream;
+}
+
+} //namespace
+
+ContentEncoding negotiateContentEncoding(std::string_view acceptEncoding)
+{
+    if (!compressionEnabled())
+        return ContentEncoding::Identity;
+
+    auto gzipQuality = std::optional<int>{};
+    auto deflateQuality = std::optional<int>{};
+    auto anyQuality = std::optional<int>{};
+    auto pos = std::size_t{};
+    while (pos < acceptEncoding.size()) {
+        const auto separatorPos = std::min(acceptEncoding.find(',', pos), acceptEncoding.size());
+        const auto element = acceptEncoding.substr(pos, separatorPos - pos);
+        pos = separatorPos + 1;
+
+        const auto paramPos = std::min(element.find(';'), element.size());
+        const auto coding = sfun::trim(element.substr(0, paramPos));
+        auto quality = 1000;
+        if (paramPos < element.size()) {
+            const auto param = sfun::trim(element.substr(paramPos + 1));
+            if (param.size() < 2 || detail::toLowerAscii(param[0]) != 'q' || param[1] != '=')
+                continue;
+            const auto qvalue = qvalueFromString(param.substr(2));
+            if (!qvalue)
+                continue;
+            quality = *qvalue;
+        }
+
+        if (detail::equalsCaseInsensitive(coding, "gzip") || detail::equalsCaseInsensitive(coding, "x-gzip"))
+            gzipQuality = quality;
+        else if (detail::equalsCaseInsensitive(coding, "deflate"))
+            deflateQuality = quality;
+        else if (coding == "*")
+            anyQuality = quality;
+    }
+
+    const auto gzip = gzipQuality.value_or(anyQuality.value_or(0));
+    const auto deflate = deflateQuality.value_or(anyQuality.value_or(0));
+    if (gzip == 0 && deflate == 0)
+        return ContentEncoding::Identity;
+    return gzip >= deflate ? ContentEncoding::Gzip : ContentEncoding::Deflate;
+}
+
+void compress(std::string_view data, ContentEncoding encoding, std::string& output, int level)
+{
+    if (encoding == ContentEncoding::Identity) {
+        output += data;
+        return;
+    }
+    threadDeflateStream(encoding, level).write(data, true, output);
+}
+
+CompressionStream::CompressionStream(ContentEncoding encoding, int level)
+    : stream_{std::make_unique<detail::DeflateStream>(encoding, level)}
+{
+}
+
+CompressionStream::~CompressionStream() = default;
+CompressionStream::CompressionStream(CompressionStream&&) noexcept = default;
+CompressionStream& CompressionStream::operator=(CompressionStream&&) noexcept = default;
+
+void CompressionStream::write(std::string_view data, std::string& output)
+{
+    stream_->write(data, false, output);
+}
+
+void CompressionStream::finish(std::string& output)
+{
+    stream_->write({}, true, output);
+}
+
+} //namespace http
@@ -1,14 +1,67 @@
+#include "detail/cookie_attributes.h"
 #include <hot_teacup/cookie.h>
 #include <hot_teacup/cookie_view.h>
+#include <hot_teacup/http_date.h>
 #include <algorithm>
 #include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace http {
 
+namespace detail {
+struct CookieTemplateData {
+    Cookie prototype;
+    /// Formatted attributes of the prototype, including the ones it inherits from its own template
+    std::vector<std::pair<CookieAttribute, std::string>> attributes;
+    std::string otherAttributes;
+};
+} //namespace detail
+
 Cookie::Cookie(const CookieView& cookieView)
-    : Cookie{Header{cookieView.asHeader()}}
+    : name_{cookieView.name()}
+    , value_{cookieView.value()}
 {
+    if (!cookieView.attributes_)
+        return;
+
+    //attributes with invalid values can't be stored and are skipped
+    for (const auto attribute : cookieView.attributes_->list) {
+        switch (attribute) {
+        case detail::CookieAttribute::Domain:
+        case detail::CookieAttribute::Path:
+        case detail::CookieAttribute::Expires:
+            setAttributeValue(attribute, cookieView.attributes_->value(attribute));
+            break;
+        case detail::CookieAttribute::MaxAge:
+            if (const auto maxAge = cookieView.maxAge())
+                setMaxAge(*maxAge);
+            break;
+        case detail::CookieAttribute::Secure:
+            setSecure();
+            break;
+        case detail::CookieAttribute::HttpOnly:
+            setHttpOnly();
+            break;
+        case detail::CookieAttribute::SameSite:
+            if (const auto sameSite = cookieView.sameSite())
+                setSameSite(*sameSite);
+            break;
+        case detail::CookieAttribute::Partitioned:
+            setPartitioned();
+            break;
+        }
+    }
+    for (const auto& param : cookieView.attributes_->otherAttributes) {
+        attributeData_ += "; ";
+        attributeData_ += param.name();
+        if (param.hasValue()) {
+            attributeData_ += '=';
+            attributeData_ += param.value();
+        }
+    }
 }
 
 Cookie::Cookie(
@@ -19,13 +72,13 @@ Cookie::Cookie(
         std::optional<std::chrono::seconds> maxAge,
         bool secure,
         bool removed)
-    : header_{"Set-Cookie", ""}
+    : name_{std::move(name)}
+    , value_{std::move(value)}
 {
-    header_.setParam(std::move(name), std::move(value));
     if (domain)
-        setDomain(*domain);
+        setDomain(std::move(*domain));
     if (path)
-        setPath(*path);
+        setPath(std::move(*path));
     if (maxAge)
         setMaxAge(*maxAge);
     if (secure)
@@ -34,89 +87,222 @@ Cookie::Cookie(
         setRemoved();
 }
 
-Cookie::Cookie(Header header)
-    : header_(std::move(header))
-{
-}
-
 const std::string& Cookie::name() const
 {
-    return header_.params().at(0).name();
+    return name_;
 }
 
 const std::string& Cookie::value() const
 {
-    return header_.params().at(0).value();
+    return value_;
 }
 
 std::optional<std::string> Cookie::domain() const
 {
-    if (header_.hasParam("Domain"))
-        return header_.param("Domain");
-    else
-        return {};
+    if (attributes_.contains(detail::CookieAttribute::Domain))
+        return std::string{attributeValue(detail::CookieAttribute::Domain)};
+    if (template_)
+        return template_->prototype.domain();
+    return std::nullopt;
 }
 
 std::optional<std::string> Cookie::path() const
 {
-    if (header_.hasParam("Path"))
-        return header_.param("Path");
-    else
-        return {};
+    if (attributes_.contains(detail::CookieAttribute::Path))
+        return std::string{attributeValue(detail::CookieAttribute::Path)};
+    if (template_)
+        return template_->prototype.path();
+    return std::nullopt;
 }
 
 std::optional<std::chrono::seconds> Cookie::maxAge() const
 {
-    if (header_.hasParam("Max-Age")) {
-        try {
-            return std::chrono::seconds{std::stoi(header_.param("Max-Age"))};
-        }
-        catch (...) {
-            return {};
-        }
-    }
-    else
-        return {};
+    if (attributes_.contains(detail::CookieAttribute::MaxAge))
+        return maxAge_;
+    if (template_)
+        return template_->prototype.maxAge();
+    return std::nullopt;
+}
+
+std::optional<std::string> Cookie::expires() const
+{
+    if (attributes_.contains(detail::CookieAttribute::Expires))
+        return std::string{attributeValue(detail::CookieAttribute::Expires)};
+    if (template_)
+        return template_->prototype.expires();
+    return std::nullopt;
+}
+
+std::optional<CookieSameSite> Cookie::sameSite() const
+{
+    if (attributes_.contains(detail::CookieAttribute::SameSite))
+        return sameSite_;
+    if (template_)
+        return template_->prototype.sameSite();
+    return std::nullopt;
 }
 
 bool Cookie::isSecure() const
 {
-    return header_.hasParam("Secure");
+    return attributes_.contains(detail::CookieAttribute::Secure) || (template_ && template_->prototype.isSecure());
+}
+
+bool Cookie::isHttpOnly() const
+{
+    return attributes_.contains(detail::CookieAttribute::HttpOnly) ||
+            (template_ && template_->prototype.isHttpOnly());
+}
+
+bool Cookie::isPartitioned() const
+{
+    return attributes_.contains(detail::CookieAttribute::Partitioned) ||
+            (template_ && template_->prototype.isPartitioned());
 }
 
 bool Cookie::isRemoved() const
 {
-    return header_.hasParam("Max-Age") && header_.param("Max-Age") == "0";
+    return maxAge() == std::chrono::seconds{0};
 }
 
 void Cookie::setDomain(std::string domain)
 {
-    header_.setParam("Domain", std::move(domain));
+    setAttributeValue(detail::CookieAttribute::Domain, domain);
 }
 
 void Cookie::setPath(std::string path)
 {
-    header_.setParam("Path", std::move(path));
+    setAttributeValue(detail::CookieAttribute::Path, path);
 }
 
 void Cookie::setMaxAge(const std::chrono::seconds& maxAge)
 {
-    header_.setParam("Max-Age", std::to_string(maxAge.count()));
+    maxAge_ = maxAge;
+    attributes_.add(detail::CookieAttribute::MaxAge);
+}
+
+void Cookie::setExpires(std::string date)
+{
+    setAttributeValue(detail::CookieAttribute::Expires, date);
+}
+
+void Cookie::setExpires(std::chrono::system_clock::time_point time)
+{
+    setExpires(httpDateToString(time));
+}
+
+void Cookie::setSameSite(CookieSameSite sameSite)
+{
+    sameSite_ = sameSite;
+    attributes_.add(detail::CookieAttribute::SameSite);
 }
 
 void Cookie::setRemoved()
 {
-    header_.setParam("Max-Age", "0");
+    setMaxAge(std::chrono::seconds{0});
 }
 
 void Cookie::setSecure()
 {
-    header_.setParam("Secure");
+    attributes_.add(detail::CookieAttribute::Secure);
+}
+
+void Cookie::setHttpOnly()
+{
+    attributes_.add(detail::CookieAttribute::HttpOnly);
+}
+
+void Cookie::setPartitioned()
+{
+    attributes_.add(detail::CookieAttribute::Partitioned);
+}
+
+namespace {
+std::size_t attributeValueIndex(detail::CookieAttribute attribute)
+{
+    switch (attribute) {
+    case detail::CookieAttribute::Domain:
+        return 0;
+    case detail::CookieAttribute::Path:
+        return 1;
+    case detail::CookieAttribute::Expires:
+        return 2;
+    default:
+        break;
+    }
+    detail::ensureNotReachable();
+}
+} //namespace
+
+std::string_view Cookie::attributeValue(detail::CookieAttribute attribute) const
+{
+    const auto index = attributeValueIndex(attribute);
+    const auto begin = index == 0 ? 0u : attributeValueEnds_[index - 1];
+    return std::string_view{attributeData_}.substr(begin, attributeValueEnds_[index] - begin);
+}
+
+void Cookie::setAttributeValue(detail::CookieAttribute attribute, std::string_view value)
+{
+    if (value.size() > std::numeric_limits<std::uint32_t>::max() - attributeData_.size())
+        throw std::length_error{"Cookie attributes are too long"};
+
+    const auto index = attributeValueIndex(attribute);
+    const auto begin = index == 0 ? 0u : attributeValueEnds_[index - 1];
+    const auto size = attributeValueEnds_[index] - begin;
+    attributeData_.replace(begin, size, value);
+    for (auto i = index; i < attributeValueEnds_.size(); ++i)
+        attributeValueEnds_[i] = attributeValueEnds_[i] - size + static_cast<std::uint32_t>(value.size());
+    attributes_.add(attribute);
+}
+
+std::string_view Cookie::otherAttributes() const
+{
+    return std::string_view{attributeData_}.substr(attributeValueEnds_.back());
+}
+
+void Cookie::appendAttribute(std::string& result, detail::CookieAttribute attribute) const
+{
+    result += "; ";
+    result += detail::cookieAttributeToString(attribute);
+    switch (attribute) {
+    case detail::CookieAttribute::Domain:
+    case detail::CookieAttribute::Path:
+    case detail::CookieAttribute::Expires:
+        result += '=';
+        result += attributeValue(attribute);
+        break;
+    case detail::CookieAttribute::MaxAge:
+        result += '=';
+        result += std::to_string(maxAge_.count());
+        break;
+    case detail::CookieAttribute::SameSite:
+        result += '=';
+        result += detail::sameSiteToString(sameSite_);
+        break;
+    case detail::CookieAttribute::Secure:
+    case detail::CookieAttribute::HttpOnly:
+    case detail::CookieAttribute::Partitioned:
+        break;
+    }
 }
 
 std::string Cookie::toString() const
 {
-    return header_.toString();
+    auto result = std::string{"Set-Cookie: "};
+    result.reserve(result.size() + name_.size() + value_.size() + 1);
+    result += name_;
+    result += '=';
+    result += value_;
+    //template attributes set on the cookie itself are replaced by its own values
+    if (template_) {
+        for (const auto& [attribute, attributeString] : template_->attributes)
+            if (!attributes_.contains(attribute))
+                result += attributeString;
+        result += template_->otherAttributes;
+    }
+    for (const auto attribute : attributes_)
+        appendAttribute(result, attribute);
+    result += otherAttributes();
+    return result;
 }
 
 bool operator==(const Cookie& lhs, const Cookie& rhs)
@@ -124,6 +310,42 @@ bool operator==(const Cookie& lhs, const Cookie& rhs)
     return lhs.name() == rhs.name() && lhs.value() == rhs.value();
 }
 
+namespace {
+std::vector<std::pair<detail::CookieAttribute, std::string>> formatTemplateAttributes(
+        const std::vector<std::pair<detail::CookieAttribute, std::string>>& inheritedAttributes,
+        const detail::CookieAttributeList& prototypeAttributes)
+{
+    auto result = std::vector<std::pair<detail::CookieAttribute, std::string>>{};
+    for (const auto& attribute : inheritedAttributes)
+        if (!prototypeAttributes.contains(attribute.first))
+            result.emplace_back(attribute);
+    return result;
+}
+} //namespace
+
+CookieTemplate::CookieTemplate(const Cookie& prototype)
+{
+    auto attributes = prototype.template_
+            ? formatTemplateAttributes(prototype.template_->attributes, prototype.attributes_)
+            : std::vector<std::pair<detail::CookieAttribute, std::string>>{};
+    for (const auto attribute : prototype.attributes_) {
+        auto attributeString = std::string{};
+        prototype.appendAttribute(attributeString, attribute);
+        attributes.emplace_back(attribute, std::move(attributeString));
+    }
+    auto otherAttributes = prototype.template_ ? prototype.template_->otherAttributes : std::string{};
+    otherAttributes += prototype.otherAttributes();
+    data_ = std::make_shared<const detail::CookieTemplateData>(
+            detail::CookieTemplateData{prototype, std::move(attributes), std::move(otherAttributes)});
+}
+
+Cookie CookieTemplate::makeCookie(std::string name, std::string value) const
+{
+    auto cookie = Cookie{std::move(name), std::move(value)};
+    cookie.template_ = data_;
+    return cookie;
+}
+
 std::string cookiesToString(const std::vector<Cookie>& cookies)
 {
     auto result = std::string{};
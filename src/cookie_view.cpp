@@ -1,71 +1,125 @@
+#include "detail/cookie_attributes.h"
 #include <hot_teacup/cookie_view.h>
 #include <sfun/string_utils.h>
+#include <algorithm>
 
 namespace http {
 
 CookieView::CookieView(std::string_view name, std::string_view value)
-    : header_{"Set-Cookie", "", {HeaderParamView{name, value}}}
+    : name_{name}
+    , value_{value}
 {
 }
 
-CookieView::CookieView(HeaderView header)
-    : header_{std::move(header)}
+CookieView::CookieView(const HeaderView& header)
+    : name_{header.params().at(0).name()}
+    , value_{header.params().at(0).value()}
 {
+    auto attributes = std::make_shared<detail::CookieViewAttributes>();
+    const auto& params = header.params();
+    //the first param is the cookie itself, when an attribute is repeated the last value is used
+    for (auto i = std::size_t{1}; i < params.size(); ++i) {
+        const auto attribute = detail::cookieAttributeFromString(params[i].name());
+        if (!attribute) {
+            attributes->otherAttributes.emplace_back(params[i]);
+            continue;
+        }
+        attributes->values[static_cast<std::size_t>(*attribute)] = params[i].value();
+        attributes->list.add(*attribute);
+    }
+    if (attributes->list.contains(detail::CookieAttribute::MaxAge))
+        attributes->maxAge = detail::maxAgeFromString(attributes->value(detail::CookieAttribute::MaxAge));
+    if (attributes->list.contains(detail::CookieAttribute::SameSite))
+        attributes->sameSite = detail::sameSiteFromString(attributes->value(detail::CookieAttribute::SameSite));
+    attributes_ = std::move(attributes);
+}
+
+bool CookieView::hasAttribute(detail::CookieAttribute attribute) const
+{
+    return attributes_ && attributes_->list.contains(attribute);
 }
 
 std::string_view CookieView::name() const
 {
-    return header_.params().at(0).name();
+    return name_;
 }
 
 std::string_view CookieView::value() const
 {
-    return header_.params().at(0).value();
+    return value_;
 }
 
 std::optional<std::string_view> CookieView::domain() const
 {
-    if (header_.hasParam("Domain"))
-        return header_.param("Domain");
-    else
-        return {};
+    if (!hasAttribute(detail::CookieAttribute::Domain))
+        return std::nullopt;
+    return attributes_->value(detail::CookieAttribute::Domain);
 }
 
 std::optional<std::string_view> CookieView::path() const
 {
-    if (header_.hasParam("Path"))
-        return header_.param("Path");
-    else
-        return {};
+    if (!hasAttribute(detail::CookieAttribute::Path))
+        return std::nullopt;
+    return attributes_->value(detail::CookieAttribute::Path);
 }
 
 std::optional<std::chrono::seconds> CookieView::maxAge() const
 {
-    if (header_.hasParam("Max-Age")) {
-        try {
-            return std::chrono::seconds{std::stoi(std::string{header_.param("Max-Age")})};
-        }
-        catch (...) {
-            return {};
-        }
-    }
-    else
-        return {};
+    if (!attributes_)
+        return std::nullopt;
+    return attributes_->maxAge;
+}
+
+std::optional<std::string_view> CookieView::expires() const
+{
+    if (!hasAttribute(detail::CookieAttribute::Expires))
+        return std::nullopt;
+    return attributes_->value(detail::CookieAttribute::Expires);
+}
+
+std::optional<CookieSameSite> CookieView::sameSite() const
+{
+    if (!attributes_)
+        return std::nullopt;
+    return attributes_->sameSite;
 }
 
 bool CookieView::isSecure() const
 {
-    return header_.hasParam("Secure");
+    return hasAttribute(detail::CookieAttribute::Secure);
+}
+
+bool CookieView::isHttpOnly() const
+{
+    return hasAttribute(detail::CookieAttribute::HttpOnly);
+}
+
+bool CookieView::isPartitioned() const
+{
+    return hasAttribute(detail::CookieAttribute::Partitioned);
 }
 
 bool CookieView::isRemoved() const
 {
-    return header_.hasParam("Max-Age") && header_.param("Max-Age") == "0";
+    return maxAge() == std::chrono::seconds{0};
 }
 
-const HeaderView& CookieView::asHeader() const
+HeaderView CookieView::asHeader() const
 {
-    return header_;
+    auto params = HeaderParamViewList{HeaderParamView{name_, value_}};
+    if (attributes_) {
+        params.reserve(attributes_->list.size() + attributes_->otherAttributes.size() + 1);
+        for (const auto attribute : attributes_->list) {
+            const auto attributeName = std::string_view{detail::cookieAttributeToString(attribute)};
+            if (detail::isCookieFlag(attribute))
+                params.emplace_back(attributeName);
+            else
+                params.emplace_back(attributeName, attributes_->value(attribute));
+        }
+        for (const auto& param : attributes_->otherAttributes)
+            params.emplace_back(param);
+    }
+    return HeaderView{"Set-Cookie", "", std::move(params)};
 }
 
 bool operator==(const CookieView& lhs, const CookieView& rhs)
@@ -75,16 +129,34 @@ bool operator==(const CookieView& lhs, const CookieView& rhs)
 
 std::vector<CookieView> cookiesFromString(std::string_view input)
 {
+    return cookiesFromString(input, ParseLimits{}).value();
+}
+
+ParseResult<std::vector<CookieView>> cookiesFromString(std::string_view input, const ParseLimits& limits)
+{
+    if (input.size() > limits.maxTotalSize)
+        return ParseError{ParseErrorCode::LimitExceeded, limits.maxTotalSize};
+    if (input.empty())
+        return std::vector<CookieView>{};
+
+    const auto cookieCount = static_cast<std::size_t>(std::count(input.begin(), input.end(), ';')) + 1;
     auto result = std::vector<CookieView>{};
-    auto cookies = sfun::split(input, ";");
-    for (const auto& cookie : cookies) {
-        const auto namePart = sfun::before(cookie, "=");
-        const auto valuePart = sfun::after(cookie, "=");
-        if (!namePart.has_value())
+    result.reserve(std::min(cookieCount, limits.maxFieldCount));
+    auto fieldCount = std::size_t{};
+    auto pos = std::size_t{};
+    while (pos < input.size()) {
+        if (++fieldCount > limits.maxFieldCount)
+            return ParseError{ParseErrorCode::LimitExceeded, pos};
+        const auto separatorPos = std::min(input.find(';', pos), input.size());
+        const auto cookie = sfun::trim(input.substr(pos, separatorPos - pos));
+        pos = separatorPos + 1;
+
+        const auto valueSeparatorPos = cookie.find('=');
+        if (valueSeparatorPos == std::string_view::npos)
             continue;
-        const auto name = sfun::trim(namePart.value());
+        const auto name = sfun::trim(cookie.substr(0, valueSeparatorPos));
         if (!name.empty())
-            result.emplace_back(name, valuePart.value_or(""));
+            result.emplace_back(name, cookie.substr(valueSeparatorPos + 1));
     }
     return result;
 }
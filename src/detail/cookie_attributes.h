@@ -0,0 +1,91 @@
+#ifndef HOT_TEACUP_COOKIE_ATTRIBUTES_H
+#define HOT_TEACUP_COOKIE_ATTRIBUTES_H
+
+#include <hot_teacup/header_view.h>
+#include <hot_teacup/types.h>
+#include <sfun/string_utils.h>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <initializer_list>
+#include <optional>
+#include <string_view>
+
+namespace http::detail {
+
+inline std::optional<CookieAttribute> cookieAttributeFromString(std::string_view name)
+{
+    switch (name.size()) {
+    case 4:
+        if (equalsCaseInsensitive(name, "Path"))
+            return CookieAttribute::Path;
+        break;
+    case 6:
+        if (equalsCaseInsensitive(name, "Domain"))
+            return CookieAttribute::Domain;
+        if (equalsCaseInsensitive(name, "Secure"))
+            return CookieAttribute::Secure;
+        break;
+    case 7:
+        if (equalsCaseInsensitive(name, "Max-Age"))
+            return CookieAttribute::MaxAge;
+        if (equalsCaseInsensitive(name, "Expires"))
+            return CookieAttribute::Expires;
+        break;
+    case 8:
+        if (equalsCaseInsensitive(name, "HttpOnly"))
+            return CookieAttribute::HttpOnly;
+        if (equalsCaseInsensitive(name, "SameSite"))
+            return CookieAttribute::SameSite;
+        break;
+    case 11:
+        if (equalsCaseInsensitive(name, "Partitioned"))
+            return CookieAttribute::Partitioned;
+        break;
+    }
+    return std::nullopt;
+}
+
+inline std::optional<std::chrono::seconds> maxAgeFromString(std::string_view value)
+{
+    value = sfun::trim(value);
+    auto seconds = std::chrono::seconds::rep{};
+    const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), seconds);
+    if (error != std::errc{} || end != value.data() + value.size())
+        return std::nullopt;
+    return std::chrono::seconds{seconds};
+}
+
+inline std::optional<CookieSameSite> sameSiteFromString(std::string_view value)
+{
+    for (auto sameSite : {CookieSameSite::Strict, CookieSameSite::Lax, CookieSameSite::None})
+        if (equalsCaseInsensitive(value, sameSiteToString(sameSite)))
+            return sameSite;
+    return std::nullopt;
+}
+
+/// Attributes of a cookie read from a Set-Cookie header, the values refer to the header data.
+/// Max-Age and SameSite are decoded once, when the attributes are read.
+struct CookieViewAttributes {
+    std::array<std::string_view, cookieAttributeCount> values;
+    CookieAttributeList list;
+    std::optional<std::chrono::seconds> maxAge;
+    std::optional<CookieSameSite> sameSite;
+    /// Params that aren't attributes known to the library, e.g. Priority, in the header order
+    HeaderParamViewList otherAttributes;
+
+    std::string_view value(CookieAttribute attribute) const
+    {
+        return values[static_cast<std::size_t>(attribute)];
+    }
+};
+
+constexpr bool isCookieFlag(CookieAttribute attribute)
+{
+    return attribute == CookieAttribute::Secure || attribute == CookieAttribute::HttpOnly ||
+            attribute == CookieAttribute::Partitioned;
+}
+
+} //namespace http::detail
+
+#endif //HOT_TEACUP_COOKIE_ATTRIBUTES_H
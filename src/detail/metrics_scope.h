@@ -0,0 +1,48 @@
+#ifndef HOT_TEACUP_METRICS_SCOPE_H
+#define HOT_TEACUP_METRICS_SCOPE_H
+
+#include <hot_teacup/metrics.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace http::detail {
+
+#ifdef HOT_TEACUP_ENABLE_METRICS
+/// Measures the enclosing instrumented call and records it in the thread metrics on destruction
+class MetricsScope {
+public:
+    MetricsScope(MetricsOperation operation, std::size_t processedBytes = 0);
+    ~MetricsScope();
+    MetricsScope(const MetricsScope&) = delete;
+    MetricsScope& operator=(const MetricsScope&) = delete;
+
+    void setProcessedBytes(std::size_t size);
+    void setElementCount(std::size_t count);
+
+private:
+    MetricsOperation operation_;
+    std::uint64_t processedBytes_;
+    std::uint64_t elementCount_ = 0;
+    std::uint64_t allocationCountOnStart_;
+    std::uint64_t allocatedBytesOnStart_;
+    std::chrono::steady_clock::time_point startTime_;
+};
+#else
+class MetricsScope {
+public:
+    MetricsScope(MetricsOperation, std::size_t = 0)
+    {
+    }
+    void setProcessedBytes(std::size_t)
+    {
+    }
+    void setElementCount(std::size_t)
+    {
+    }
+};
+#endif
+
+} //namespace http::detail
+
+#endif //HOT_TEACUP_METRICS_SCOPE_H
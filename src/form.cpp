@@ -2,8 +2,22 @@
 #include <hot_teacup/form_view.h>
 #include <hot_teacup/header.h>
 #include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <fstream>
 #include <iterator>
 #include <optional>
+#include <random>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <io.h>
+#include <share.h>
+#else
+#include <unistd.h>
+#endif
 
 namespace http {
 
@@ -13,18 +27,116 @@ FormField::FormField(const FormFieldView& fieldView)
         value_ = FormFile{
                 std::string{fieldView.value()},
                 std::string{fieldView.fileName()},
-                std::string{fieldView.fileType()}};
+                std::string{fieldView.fileType()},
+                {}};
     else
         value_ = std::string{fieldView.value()};
 }
 
+namespace {
+/// Opens a new file readable and writable only by the current user, the existing paths (including symlinks) aren't
+/// reused, so another local user can't substitute the file between the name check and its creation.
+/// Returns -1 on failure, with errno set.
+int createFileExclusively(const std::filesystem::path& path)
+{
+#ifdef _WIN32
+    auto fd = -1;
+    _wsopen_s(&fd, path.c_str(), _O_WRONLY | _O_CREAT | _O_EXCL | _O_BINARY, _SH_DENYNO, _S_IREAD | _S_IWRITE);
+    return fd;
+#else
+    return ::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, S_IRUSR | S_IWUSR);
+#endif
+}
+
+bool writeFile(int fd, std::string_view data)
+{
+    while (!data.empty()) {
+#ifdef _WIN32
+        const auto chunkSize = static_cast<unsigned int>(std::min<std::size_t>(data.size(), INT_MAX));
+        const auto writtenSize = _write(fd, data.data(), chunkSize);
+#else
+        const auto writtenSize = ::write(fd, data.data(), data.size());
+#endif
+        if (writtenSize < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        data.remove_prefix(static_cast<std::size_t>(writtenSize));
+    }
+    return true;
+}
+
+bool closeFile(int fd)
+{
+#ifdef _WIN32
+    return _close(fd) == 0;
+#else
+    return ::close(fd) == 0;
+#endif
+}
+
+std::shared_ptr<const std::filesystem::path> spoolFile(std::string_view fileData, const FormFileSpooling& fileSpooling)
+{
+    const auto& directory =
+            fileSpooling.directory.empty() ? std::filesystem::temp_directory_path() : fileSpooling.directory;
+
+    thread_local auto randomEngine = std::mt19937_64{std::random_device{}()};
+    for (auto attempt = 0; attempt < 16; ++attempt) {
+        auto path = directory / ("hot_teacup_" + std::to_string(randomEngine()) + ".tmp");
+        const auto fd = createFileExclusively(path);
+        if (fd == -1) {
+            if (errno == EEXIST)
+                continue;
+            throw std::runtime_error{"Can't create the form file '" + path.string() + "'"};
+        }
+
+        auto filePath = std::shared_ptr<const std::filesystem::path>{
+                new std::filesystem::path{std::move(path)},
+                [](const std::filesystem::path* path)
+                {
+                    auto ec = std::error_code{};
+                    std::filesystem::remove(*path, ec);
+                    delete path;
+                }};
+        const auto isWritten = writeFile(fd, fileData);
+        if (!closeFile(fd) || !isWritten)
+            throw std::runtime_error{"Can't write the form file to '" + filePath->string() + "'"};
+        return filePath;
+    }
+    throw std::runtime_error{"Can't create a unique file in directory '" + directory.string() + "'"};
+}
+
+std::string readFile(const std::filesystem::path& filePath)
+{
+    auto file = std::ifstream{filePath, std::ios::binary};
+    if (!file)
+        throw std::runtime_error{"Can't read the form file '" + filePath.string() + "'"};
+    auto result = std::string(static_cast<std::size_t>(std::filesystem::file_size(filePath)), '\0');
+    file.read(result.data(), static_cast<std::streamsize>(result.size()));
+    return result;
+}
+} //namespace
+
+FormField::FormField(const FormFieldView& fieldView, const FormFileSpooling& fileSpooling)
+{
+    if (fieldView.hasFile() && fieldView.value().size() > fileSpooling.sizeThreshold)
+        value_ = FormFile{
+                {},
+                std::string{fieldView.fileName()},
+                std::string{fieldView.fileType()},
+                spoolFile(fieldView.value(), fileSpooling)};
+    else
+        *this = FormField{fieldView};
+}
+
 FormField::FormField(std::string value)
     : value_{std::move(value)}
 {
 }
 
 FormField::FormField(std::string fileData, std::string fileName, std::optional<std::string> fileType)
-    : value_{FormFile{std::move(fileData), std::move(fileName), std::move(fileType)}}
+    : value_{FormFile{std::move(fileData), std::move(fileName), std::move(fileType), {}}}
 {
 }
 
@@ -67,6 +179,21 @@ const std::string& FormField::value() const
         return std::get<FormFile>(value_).fileData;
 }
 
+const std::filesystem::path& FormField::filePath() const
+{
+    if (type() == FormFieldType::File) {
+        const auto& res = std::get<FormFile>(value_).filePath;
+        return res ? *res : pathNotFound;
+    }
+    else
+        return pathNotFound;
+}
+
+bool FormField::isFileSpooled() const
+{
+    return type() == FormFieldType::File && std::get<FormFile>(value_).filePath;
+}
+
 std::string urlEncodedFormToString(const Form& form)
 {
     auto result = std::string{};
@@ -98,7 +225,7 @@ std::string multipartFormToString(const Form& form, const std::string& formBound
             if (fileHeader)
                 result += fileHeader->toString() + "\r\n";
             result += "\r\n";
-            result += field.value() + "\r\n";
+            result += (field.isFileSpooled() ? readFile(field.filePath()) : field.value()) + "\r\n";
         }
     }
     if (!form.empty())
@@ -120,4 +247,18 @@ Form makeForm(const std::map<std::string, FormFieldView>& formView)
     return result;
 }
 
+Form makeForm(const std::map<std::string, FormFieldView>& formView, const FormFileSpooling& fileSpooling)
+{
+    auto result = Form{};
+    std::transform(
+            formView.begin(),
+            formView.end(),
+            std::inserter(result, result.end()),
+            [&fileSpooling](const auto& fieldViewPair)
+            {
+                return std::pair{fieldViewPair.first, FormField{fieldViewPair.second, fileSpooling}};
+            });
+    return result;
+}
+
 } //namespace http
\ No newline at end of file
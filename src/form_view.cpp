@@ -1,7 +1,11 @@
+#include "detail/metrics_scope.h"
 #include <hot_teacup/form_view.h>
 #include <hot_teacup/header_view.h>
+#include <hot_teacup/types.h>
 #include <sfun/string_utils.h>
+#include <algorithm>
 #include <optional>
+#include <utility>
 
 namespace http {
 
@@ -72,119 +76,235 @@ std::string_view getStringLine(std::string_view input, std::size_t& pos, std::st
     return input.substr(linePos, lineSize);
 }
 
+/// Values of the part headers used to create a form field
+struct PartHeaders {
+    std::optional<std::string_view> name;
+    std::optional<std::string_view> fileName;
+    std::optional<std::string_view> fileType;
+};
+
+std::string_view unquoted(std::string_view str)
+{
+    if (sfun::starts_with(str, "\""))
+        str.remove_prefix(1);
+    if (sfun::ends_with(str, "\""))
+        str.remove_suffix(1);
+    return str;
+}
+
+/// Reads the "name" and "filename" params of Content-Disposition header,
+/// the first value is used when a param is repeated, like in HeaderView::param()
+void readContentDispositionParams(std::string_view value, PartHeaders& headers)
+{
+    headers.name = std::nullopt;
+    headers.fileName = std::nullopt;
+    auto isFirstPart = true;
+    auto pos = std::size_t{};
+    while (pos < value.size()) {
+        const auto separatorPos = std::min(value.find(';', pos), value.size());
+        const auto part = value.substr(pos, separatorPos - pos);
+        pos = separatorPos + 1;
+
+        const auto equalPos = part.find('=');
+        //the header value, like "form-data", is a param only when it contains '='
+        if (std::exchange(isFirstPart, false) && equalPos == std::string_view::npos)
+            continue;
+        const auto paramName = equalPos == std::string_view::npos ? sfun::trim(part)
+                                                                  : sfun::trim_front(part.substr(0, equalPos));
+        const auto paramValue =
+                equalPos == std::string_view::npos ? std::string_view{} : unquoted(part.substr(equalPos + 1));
+        if (!headers.name && detail::equalsCaseInsensitive(paramName, "name"))
+            headers.name = paramValue;
+        else if (!headers.fileName && detail::equalsCaseInsensitive(paramName, "filename"))
+            headers.fileName = paramValue;
+    }
+}
+
+/// Content-Type value without params, like HeaderView::value()
+std::string_view readContentTypeValue(std::string_view value)
+{
+    const auto type = unquoted(sfun::trim_front(value.substr(0, value.find(';'))));
+    if (type.find('=') != std::string_view::npos)
+        return {};
+    return type;
+}
+
 /// Reads HTTP headers between two blank lines
-/// Returns a tuple { Content-Disposition header if found,
-///                   Content-Type header if found
-///                 }
-/// if input is not at the end and has a valid state
+/// Returns values of Content-Disposition and Content-Type headers if found,
+/// if input is not at the end and has a valid state,
+/// the error is set if the input isn't at the form's closing separator,
+/// which must be "--" optionally followed by whitespace
 ///
-std::optional<std::tuple<std::optional<HeaderView>, std::optional<HeaderView>>> readContentHeaders(
+std::optional<PartHeaders> readContentHeaders(
         std::string_view input,
-        std::size_t& pos)
+        std::size_t& pos,
+        const ParseLimits& limits,
+        std::optional<ParseError>& error)
 {
+    const auto separatorEndPos = pos;
     auto headerLine = getStringLine(input, pos);
-    if (!headerLine.empty() || pos == input.size())
+    if (!headerLine.empty() || pos == input.size()) {
+        if (headerLine.empty())
+            error = ParseError{ParseErrorCode::TruncatedMultipartForm, input.size()};
+        else if (!sfun::starts_with(headerLine, "--") || !sfun::trim(headerLine.substr(2)).empty())
+            error = ParseError{ParseErrorCode::InvalidMultipartForm, separatorEndPos};
         return {};
+    }
     else
         headerLine = getStringLine(input, pos);
 
-    auto contentDisposition = std::optional<HeaderView>{};
-    auto contentType = std::optional<HeaderView>{};
+    //only the header name is read before the header is classified,
+    //the values of the other headers are skipped without tokenizing
+    auto result = PartHeaders{};
+    auto headerCount = std::size_t{};
     while (!headerLine.empty()) {
-        auto header = headerFromString(headerLine);
-        if (header.has_value()) {
-            if (header->name() == "Content-Disposition")
-                contentDisposition = std::move(header);
-            else if (header->name() == "Content-Type")
-                contentType = std::move(header);
+        if (headerLine.size() > limits.maxHeaderLineLength || ++headerCount > limits.maxFieldCount) {
+            error = ParseError{ParseErrorCode::LimitExceeded, pos - headerLine.size()};
+            return {};
+        }
+        const auto nameSeparatorPos = headerLine.find(':');
+        if (nameSeparatorPos != std::string_view::npos) {
+            const auto knownHeader = knownHeaderFromString(sfun::trim(headerLine.substr(0, nameSeparatorPos)));
+            const auto value = headerLine.substr(nameSeparatorPos + 1);
+            if (knownHeader == KnownHeader::ContentDisposition)
+                readContentDispositionParams(value, result);
+            else if (knownHeader == KnownHeader::ContentType)
+                result.fileType = readContentTypeValue(value);
         }
         headerLine = getStringLine(input, pos);
     }
-    return std::make_tuple(std::move(contentDisposition), std::move(contentType));
+    return result;
 }
 
-FormView parseFormFieldViews(std::string_view input, std::string_view boundary)
+FormView parseFormFieldViews(
+        std::string_view input,
+        std::string_view boundary,
+        const ParseLimits& limits,
+        std::optional<ParseError>& error)
 {
     const auto separator = "--" + std::string{boundary};
-    const auto endSeparator = "--" + std::string{boundary} + "--";
 
     auto pos = std::size_t{};
     auto firstSeparatorLine = getStringLine(input, pos, separator);
-    if (!firstSeparatorLine.empty()) //a form must start with a "--<boundary>" separator
+    if (!firstSeparatorLine.empty()) { //a form must start with a "--<boundary>" separator
+        error = ParseError{ParseErrorCode::InvalidMultipartForm, 0};
         return {};
+    }
 
     auto result = FormView{};
+    auto partCount = std::size_t{};
     while (pos < input.size()) {
-        auto contentHeaders = readContentHeaders(input, pos);
+        const auto partPos = pos;
+        auto contentHeaders = readContentHeaders(input, pos, limits, error);
         if (!contentHeaders)
             return result;
+        if (++partCount > limits.maxPartCount) {
+            error = ParseError{ParseErrorCode::LimitExceeded, partPos};
+            return result;
+        }
 
-        auto& [contentDisposition, contentType] = *contentHeaders;
+        const auto& [paramName, fileName, fileType] = *contentHeaders;
         auto content = getStringLine(input, pos, separator);
-        if (!contentDisposition.has_value() || !contentDisposition->hasParam("name") ||
-            contentDisposition->param("name").empty())
+        if (!paramName.has_value() || paramName->empty())
             continue;
 
         if (content.size() >= 2)
             content.remove_suffix(2); //remove \r\n
 
-        const auto& paramName = contentDisposition->param("name");
-        if (contentDisposition->hasParam("filename")) {
-            const auto& fileName = contentDisposition->param("filename");
-            auto fileType = std::optional<std::string_view>{};
-            if (contentType.has_value())
-                fileType = contentType->value();
-            result.emplace(std::string{paramName}, FormFieldView{content, fileName, fileType});
-        }
+        if (fileName.has_value())
+            result.emplace(std::string{*paramName}, FormFieldView{content, *fileName, fileType});
         else
-            result.emplace(std::string{paramName}, FormFieldView{content});
+            result.emplace(std::string{*paramName}, FormFieldView{content});
     }
+    //the closing "--<boundary>--" separator is handled by readContentHeaders, reaching the end means it's missing
+    error = ParseError{ParseErrorCode::TruncatedMultipartForm, input.size()};
     return result;
 }
 
-std::tuple<std::string_view, std::string_view> parseUrlEncodedParamString(std::string_view paramStr)
-{
-    const auto namePart = sfun::before(paramStr, "=");
-    if (!namePart.has_value())
-        return {};
-
-    const auto name = sfun::trim(namePart.value());
-    if (name.empty())
-        return {};
-
-    const auto val = sfun::after(paramStr, "=").value();
-    return {name, val};
-}
-
-FormView parseUrlEncodedFields(std::string_view input)
+FormView parseUrlEncodedFields(std::string_view input, const ParseLimits& limits, std::optional<ParseError>& error)
 {
-    auto pos = std::size_t{0u};
+    //a single forward scan: each field is delimited with find(char), which is a memchr call,
+    //and its name and value are emitted as views of the input
     auto result = FormView{};
+    auto fieldCount = std::size_t{};
+    auto pos = std::size_t{};
     do {
-        auto param = getStringLine(input, pos, "&");
-        auto [paramName, paramValue] = parseUrlEncodedParamString(param);
-        if (paramName.empty())
+        if (++fieldCount > limits.maxFieldCount) {
+            error = ParseError{ParseErrorCode::LimitExceeded, pos};
+            return result;
+        }
+        const auto separatorPos = std::min(input.find('&', pos), input.size());
+        const auto field = input.substr(pos, separatorPos - pos);
+        pos = separatorPos + 1;
+
+        const auto valueSeparatorPos = field.find('=');
+        if (valueSeparatorPos == std::string_view::npos)
             continue;
-        result.emplace(paramName, FormFieldView{paramValue});
-    }
-    while (pos < input.size());
+        const auto name = sfun::trim(field.substr(0, valueSeparatorPos));
+        if (name.empty())
+            continue;
+        result.try_emplace(std::string{name}, field.substr(valueSeparatorPos + 1));
+    } while (pos < input.size());
     return result;
 }
-} //namespace
 
-FormView formFromString(std::string_view contentParam, std::string_view contentFields)
+/// Returns the fields parsed before the first error, which is stored in the error parameter
+FormView parseForm(
+        std::string_view contentParam,
+        std::string_view contentFields,
+        const ParseLimits& limits,
+        std::optional<ParseError>& error)
 {
+    if (contentFields.size() > limits.maxTotalSize) {
+        error = ParseError{ParseErrorCode::LimitExceeded, limits.maxTotalSize};
+        return {};
+    }
+
     auto contentTypeHeader = "Content-Type: " + std::string{contentParam};
-    auto contentType = headerFromString(contentTypeHeader);
-    if (!contentType.has_value())
+    auto contentType = headerFromString(contentTypeHeader, limits);
+    if (!contentType) {
+        if (contentType.error().code == ParseErrorCode::LimitExceeded)
+            error = ParseError{ParseErrorCode::LimitExceeded, 0};
         return {};
+    }
 
-    if (contentType->value() == "multipart/form-data" && contentType->hasParam("boundary"))
-        return parseFormFieldViews(contentFields, contentType->param("boundary"));
-    else if (contentType->value() == "application/x-www-form-urlencoded")
-        return parseUrlEncodedFields(contentFields);
+    if (detail::equalsCaseInsensitive(contentType->value(), "multipart/form-data")) {
+        if (!contentType->hasParam("boundary")) {
+            error = ParseError{ParseErrorCode::MissingFormBoundary, 0};
+            return {};
+        }
+        if (contentFields.empty())
+            return {};
+        return parseFormFieldViews(contentFields, contentType->param("boundary"), limits, error);
+    }
+    else if (detail::equalsCaseInsensitive(contentType->value(), "application/x-www-form-urlencoded"))
+        return parseUrlEncodedFields(contentFields, limits, error);
 
     return {};
 }
+} //namespace
+
+FormView formFromString(std::string_view contentParam, std::string_view contentFields)
+{
+    auto metrics = detail::MetricsScope{MetricsOperation::FormParsing, contentFields.size()};
+    auto error = std::optional<ParseError>{};
+    auto result = parseForm(contentParam, contentFields, ParseLimits{}, error);
+    metrics.setElementCount(result.size());
+    return result;
+}
+
+ParseResult<FormView> formFromString(
+        std::string_view contentParam,
+        std::string_view contentFields,
+        const ParseLimits& limits)
+{
+    auto metrics = detail::MetricsScope{MetricsOperation::FormParsing, contentFields.size()};
+    auto error = std::optional<ParseError>{};
+    auto result = parseForm(contentParam, contentFields, limits, error);
+    if (error)
+        return *error;
+    metrics.setElementCount(result.size());
+    return result;
+}
 
 } //namespace http
\ No newline at end of file
@@ -1,7 +1,5 @@
 #include <hot_teacup/header.h>
 #include <hot_teacup/header_view.h>
-#include <algorithm>
-#include <iterator>
 #include <stdexcept>
 #include <utility>
 
@@ -73,7 +71,7 @@ void Header::setParam(std::string name)
         return;
 
     for (auto& param : params_)
-        if (param.name() == name) {
+        if (detail::equalsCaseInsensitive(param.name(), name)) {
             param = HeaderParam{std::move(name)};
             return;
         }
@@ -86,7 +84,7 @@ void Header::setParam(std::string name, std::string value)
         return;
 
     for (auto& param : params_)
-        if (param.name() == name) {
+        if (detail::equalsCaseInsensitive(param.name(), name)) {
             param = HeaderParam{std::move(name), std::move(value)};
             return;
         }
@@ -119,7 +117,7 @@ std::string valueStr(const std::string& value, bool hasParams, HeaderQuotingMode
 
 } //namespace
 
-const std::vector<HeaderParam>& Header::params() const
+const HeaderParamList& Header::params() const
 {
     return params_;
 }
@@ -127,7 +125,7 @@ const std::vector<HeaderParam>& Header::params() const
 const std::string& Header::param(std::string_view name) const
 {
     for (const auto& param : params_)
-        if (param.name() == name)
+        if (detail::equalsCaseInsensitive(param.name(), name))
             return param.value();
     throw std::out_of_range{"Header doesn't contain param '" + std::string{name} + "'"};
 }
@@ -135,7 +133,7 @@ const std::string& Header::param(std::string_view name) const
 bool Header::hasParam(std::string_view name) const
 {
     for (const auto& param : params_)
-        if (param.name() == name)
+        if (detail::equalsCaseInsensitive(param.name(), name))
             return true;
     return false;
 }
@@ -164,31 +162,34 @@ const std::string& Header::value() const
     return value_;
 }
 
-std::vector<HeaderParam> makeHeaderParams(const std::vector<HeaderParamView>& headerParamViewList)
+namespace {
+template<typename THeaderParamList, typename THeaderParamViewList>
+THeaderParamList makeHeaderParamList(const THeaderParamViewList& headerParamViewList)
 {
-    auto result = std::vector<HeaderParam>{};
-    std::transform(
-            headerParamViewList.begin(),
-            headerParamViewList.end(),
-            std::back_inserter(result),
-            [](const auto& headerParamView)
-            {
-                return HeaderParam{headerParamView};
-            });
+    auto result = THeaderParamList{};
+    result.reserve(headerParamViewList.size());
+    for (const auto& headerParamView : headerParamViewList)
+        result.emplace_back(headerParamView);
     return result;
 }
+} //namespace
+
+HeaderParamList makeHeaderParams(const HeaderParamViewList& headerParamViewList)
+{
+    return makeHeaderParamList<HeaderParamList>(headerParamViewList);
+}
+
+std::vector<HeaderParam> makeHeaderParams(const std::vector<HeaderParamView>& headerParamViewList)
+{
+    return makeHeaderParamList<std::vector<HeaderParam>>(headerParamViewList);
+}
 
 std::vector<Header> makeHeaders(const std::vector<HeaderView>& headerViewList)
 {
     auto result = std::vector<Header>{};
-    std::transform(
-            headerViewList.begin(),
-            headerViewList.end(),
-            std::back_inserter(result),
-            [](const auto& headerView)
-            {
-                return Header{headerView};
-            });
+    result.reserve(headerViewList.size());
+    for (const auto& headerView : headerViewList)
+        result.emplace_back(headerView);
     return result;
 }
 
@@ -1,5 +1,7 @@
 #include <hot_teacup/header_view.h>
+#include <hot_teacup/types.h>
 #include <sfun/string_utils.h>
+#include <algorithm>
 #include <stdexcept>
 #include <utility>
 
@@ -31,14 +33,14 @@ bool HeaderParamView::hasValue() const
     return value_.has_value();
 }
 
-HeaderView::HeaderView(std::string_view name, std::string_view value, std::vector<HeaderParamView> params)
+HeaderView::HeaderView(std::string_view name, std::string_view value, HeaderParamViewList params)
     : name_{name}
     , value_{value}
     , params_{std::move(params)}
 {
 }
 
-const std::vector<HeaderParamView>& HeaderView::params() const
+const HeaderParamViewList& HeaderView::params() const
 {
     return params_;
 }
@@ -46,7 +48,7 @@ const std::vector<HeaderParamView>& HeaderView::params() const
 std::string_view HeaderView::param(std::string_view name) const
 {
     for (const auto& param : params_)
-        if (param.name() == name)
+        if (detail::equalsCaseInsensitive(param.name(), name))
             return param.value();
     throw std::out_of_range{"Header doesn't contain param '" + std::string{name} + "'"};
 }
@@ -54,7 +56,7 @@ std::string_view HeaderView::param(std::string_view name) const
 bool HeaderView::hasParam(std::string_view name) const
 {
     for (const auto& param : params_)
-        if (param.name() == name)
+        if (detail::equalsCaseInsensitive(param.name(), name))
             return true;
     return false;
 }
@@ -71,8 +73,12 @@ std::string_view unquoted(std::string_view str)
 
 std::optional<HeaderParamView> makeParam(std::string_view paramPart)
 {
-    if (paramPart.find('=') == std::string::npos)
-        return {};
+    if (paramPart.find('=') == std::string::npos) {
+        const auto name = sfun::trim(paramPart);
+        if (name.empty())
+            return {};
+        return HeaderParamView{name};
+    }
     const auto name = sfun::trim_front(sfun::before(paramPart, "=").value());
     const auto value = unquoted(sfun::after(paramPart, "=").value());
     return HeaderParamView{name, value};
@@ -82,38 +88,57 @@ std::optional<HeaderParamView> makeParam(std::string_view paramPart)
 
 std::optional<HeaderView> headerFromString(std::string_view input)
 {
-    const auto parts = sfun::split(input, ";", false);
-    if (parts.empty())
-        return {};
-
-    if (parts[0].find(':') == std::string::npos)
-        return {};
-
-    const auto name = sfun::trim(sfun::before(parts[0], ":").value());
-    const auto value = unquoted(sfun::trim_front(sfun::after(parts[0], ":").value()));
-    if (name.empty())
-        return {};
-
-    const auto valueIsParam = (value.find('=') != std::string::npos);
-    if (valueIsParam) {
-        auto params = std::vector<HeaderParamView>{};
-        auto param = makeParam(value);
-        if (param)
-            params.emplace_back(*param);
-        for (auto i = 1u; i < parts.size(); ++i) {
-            param = makeParam(parts[i]);
-            if (param)
+    auto result = headerFromString(input, ParseLimits{});
+    if (!result)
+        return std::nullopt;
+    return std::move(*result);
+}
+
+ParseResult<HeaderView> headerFromString(std::string_view input, const ParseLimits& limits)
+{
+    if (input.size() > limits.maxHeaderLineLength || input.size() > limits.maxTotalSize)
+        return ParseError{ParseErrorCode::LimitExceeded, std::min(limits.maxHeaderLineLength, limits.maxTotalSize)};
+
+    //the first non-empty part between ';' separators is "name: value", the following ones are params
+    auto name = std::string_view{};
+    auto value = std::string_view{};
+    auto params = HeaderParamViewList{};
+    auto isValid = true;
+    auto partCount = std::size_t{};
+    auto pos = std::size_t{};
+    while (pos < input.size()) {
+        const auto partPos = pos;
+        const auto separatorPos = std::min(input.find(';', pos), input.size());
+        const auto part = input.substr(pos, separatorPos - pos);
+        pos = separatorPos + 1;
+        if (part.empty())
+            continue;
+        if (++partCount > limits.maxFieldCount)
+            return ParseError{ParseErrorCode::LimitExceeded, partPos};
+        if (!isValid)
+            continue;
+
+        if (partCount > 1) {
+            if (const auto param = makeParam(part))
                 params.emplace_back(*param);
+            continue;
+        }
+        const auto nameSeparatorPos = part.find(':');
+        if (nameSeparatorPos == std::string_view::npos) {
+            isValid = false;
+            continue;
+        }
+        name = sfun::trim(part.substr(0, nameSeparatorPos));
+        value = unquoted(sfun::trim_front(part.substr(nameSeparatorPos + 1)));
+        if (value.find('=') != std::string_view::npos) {
+            if (const auto param = makeParam(value))
+                params.emplace_back(*param);
+            value = {};
         }
-        return HeaderView{name, {}, std::move(params)};
     }
-
-    auto params = std::vector<HeaderParamView>{};
-    for (auto i = 1u; i < parts.size(); ++i)
-        if (const auto param = makeParam(parts[i]))
-            params.emplace_back(*param);
+    if (!isValid || name.empty())
+        return ParseError{ParseErrorCode::InvalidHeader, 0};
     return HeaderView{name, value, std::move(params)};
-
 }
 
 std::string_view HeaderView::name() const
@@ -0,0 +1,196 @@
+#include <hot_teacup/http_date.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace http {
+
+namespace {
+constexpr auto httpDateSize = std::size_t{29};
+constexpr auto secondsInDay = std::int64_t{24 * 60 * 60};
+constexpr auto dayNames = std::string_view{"SunMonTueWedThuFriSat"};
+constexpr auto monthNames = std::string_view{"JanFebMarAprMayJunJulAugSepOctNovDec"};
+
+constexpr std::array<char, 200> makeDigitPairs()
+{
+    auto result = std::array<char, 200>{};
+    for (auto i = 0; i < 100; ++i) {
+        result[static_cast<std::size_t>(i * 2)] = static_cast<char>('0' + i / 10);
+        result[static_cast<std::size_t>(i * 2 + 1)] = static_cast<char>('0' + i % 10);
+    }
+    return result;
+}
+constexpr auto digitPairs = makeDigitPairs();
+
+struct CivilDate {
+    std::int64_t year;
+    int month;
+    int day;
+};
+
+// Conversions between days since the epoch and the proleptic Gregorian calendar,
+// based on http://howardhinnant.github.io/date_algorithms.html
+CivilDate civilFromDays(std::int64_t days)
+{
+    days += 719468;
+    const auto era = (days >= 0 ? days : days - 146096) / 146097;
+    const auto dayOfEra = days - era * 146097;
+    const auto yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const auto dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const auto monthIndex = (5 * dayOfYear + 2) / 153;
+    const auto day = static_cast<int>(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+    const auto month = static_cast<int>(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+    return {yearOfEra + era * 400 + (month <= 2 ? 1 : 0), month, day};
+}
+
+std::int64_t daysFromCivil(std::int64_t year, int month, int day)
+{
+    year -= month <= 2 ? 1 : 0;
+    const auto era = (year >= 0 ? year : year - 399) / 400;
+    const auto yearOfEra = year - era * 400;
+    const auto dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const auto dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+int daysInMonth(std::int64_t year, int month)
+{
+    constexpr auto days = std::array<int, 12>{31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    const auto isLeapYear = year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+    return month == 2 && isLeapYear ? 29 : days[static_cast<std::size_t>(month - 1)];
+}
+
+int weekDayFromDays(std::int64_t days)
+{
+    return static_cast<int>((days % 7 + 11) % 7); //the epoch was on Thursday
+}
+
+//IMF-fixdate has a four digit year, so the formatted time is limited to 0000-01-01 - 9999-12-31
+const auto minFormattedSeconds = daysFromCivil(0, 1, 1) * secondsInDay;
+const auto maxFormattedSeconds = daysFromCivil(10000, 1, 1) * secondsInDay - 1;
+
+char* writeDigitPair(char* out, std::int64_t value)
+{
+    const auto index = static_cast<std::size_t>(value * 2);
+    *out++ = digitPairs[index];
+    *out++ = digitPairs[index + 1];
+    return out;
+}
+
+char* writeName(char* out, std::string_view names, std::int64_t index)
+{
+    const auto name = names.substr(static_cast<std::size_t>(index * 3), 3);
+    for (auto ch : name)
+        *out++ = ch;
+    return out;
+}
+
+/// Times outside of the representable range are clamped to its bounds
+void formatHttpDate(std::int64_t secondsSinceEpoch, char* out)
+{
+    secondsSinceEpoch = std::clamp(secondsSinceEpoch, minFormattedSeconds, maxFormattedSeconds);
+    auto days = secondsSinceEpoch / secondsInDay;
+    if (secondsSinceEpoch % secondsInDay < 0)
+        --days;
+    const auto secondOfDay = secondsSinceEpoch - days * secondsInDay;
+    const auto date = civilFromDays(days);
+    const auto weekDay = weekDayFromDays(days);
+
+    out = writeName(out, dayNames, weekDay);
+    *out++ = ',';
+    *out++ = ' ';
+    out = writeDigitPair(out, date.day);
+    *out++ = ' ';
+    out = writeName(out, monthNames, date.month - 1);
+    *out++ = ' ';
+    out = writeDigitPair(out, date.year / 100 % 100);
+    out = writeDigitPair(out, date.year % 100);
+    *out++ = ' ';
+    out = writeDigitPair(out, secondOfDay / 3600);
+    *out++ = ':';
+    out = writeDigitPair(out, secondOfDay / 60 % 60);
+    *out++ = ':';
+    out = writeDigitPair(out, secondOfDay % 60);
+    for (auto ch : std::string_view{" GMT"})
+        *out++ = ch;
+}
+
+std::int64_t toSeconds(std::chrono::system_clock::time_point time)
+{
+    return std::chrono::floor<std::chrono::seconds>(time.time_since_epoch()).count();
+}
+
+std::optional<int> readNumber(std::string_view str)
+{
+    auto result = 0;
+    for (auto ch : str) {
+        if (ch < '0' || ch > '9')
+            return std::nullopt;
+        result = result * 10 + (ch - '0');
+    }
+    return result;
+}
+
+std::optional<int> readName(std::string_view names, std::string_view name)
+{
+    for (auto i = std::size_t{}; i < names.size(); i += 3)
+        if (names.substr(i, 3) == name)
+            return static_cast<int>(i / 3);
+    return std::nullopt;
+}
+
+} //namespace
+
+std::string httpDateToString(std::chrono::system_clock::time_point time)
+{
+    auto result = std::string(httpDateSize, '\0');
+    formatHttpDate(toSeconds(time), result.data());
+    return result;
+}
+
+std::string_view currentHttpDate()
+{
+    thread_local auto cachedSecond = std::numeric_limits<std::int64_t>::min();
+    thread_local auto cachedDate = std::array<char, httpDateSize>{};
+
+    const auto second = toSeconds(std::chrono::system_clock::now());
+    if (second != cachedSecond) {
+        formatHttpDate(second, cachedDate.data());
+        cachedSecond = second;
+    }
+    return {cachedDate.data(), cachedDate.size()};
+}
+
+std::optional<std::chrono::system_clock::time_point> httpDateFromString(std::string_view date)
+{
+    //Sun, 06 Nov 1994 08:49:37 GMT
+    if (date.size() != httpDateSize || date.substr(3, 2) != ", " || date[7] != ' ' || date[11] != ' ' ||
+        date[16] != ' ' || date[19] != ':' || date[22] != ':' || date.substr(25) != " GMT")
+        return std::nullopt;
+
+    const auto weekDay = readName(dayNames, date.substr(0, 3));
+    const auto day = readNumber(date.substr(5, 2));
+    const auto month = readName(monthNames, date.substr(8, 3));
+    const auto year = readNumber(date.substr(12, 4));
+    const auto hour = readNumber(date.substr(17, 2));
+    const auto minute = readNumber(date.substr(20, 2));
+    const auto second = readNumber(date.substr(23, 2));
+    if (!weekDay || !day || !month || !year || !hour || !minute || !second)
+        return std::nullopt;
+    if (*day < 1 || *day > daysInMonth(*year, *month + 1) || *hour > 23 || *minute > 59 || *second > 60)
+        return std::nullopt;
+
+    const auto days = daysFromCivil(*year, *month + 1, *day);
+    if (weekDayFromDays(days) != *weekDay)
+        return std::nullopt;
+    const auto seconds = days * secondsInDay + *hour * 3600 + *minute * 60 + *second;
+    //system_clock can have a range narrower than the format, e.g. libstdc++ nanoseconds cover the years 1677-2262
+    const auto minSeconds = std::chrono::ceil<std::chrono::seconds>(std::chrono::system_clock::duration::min());
+    const auto maxSeconds = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::duration::max());
+    if (seconds < minSeconds.count() || seconds > maxSeconds.count())
+        return std::nullopt;
+    return std::chrono::system_clock::time_point{std::chrono::seconds{seconds}};
+}
+
+} //namespace http
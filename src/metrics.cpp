@@ -0,0 +1,137 @@
+#include "detail/metrics_scope.h"
+#include <hot_teacup/metrics.h>
+#include <hot_teacup/types.h>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+namespace http {
+
+namespace {
+Metrics& metricsStorage()
+{
+    thread_local auto metrics = Metrics{};
+    return metrics;
+}
+
+MetricsCallback& metricsCallback()
+{
+    static auto callback = MetricsCallback{};
+    return callback;
+}
+
+#ifdef HOT_TEACUP_ENABLE_METRICS
+struct AllocationCounters {
+    std::uint64_t count;
+    std::uint64_t bytes;
+};
+thread_local AllocationCounters allocationCounters = {};
+
+OperationMetrics& operationMetrics(MetricsOperation operation)
+{
+    auto& metrics = metricsStorage();
+    switch (operation) {
+    case MetricsOperation::RequestViewParsing:
+        return metrics.requestViewParsing;
+    case MetricsOperation::FormParsing:
+        return metrics.formParsing;
+    case MetricsOperation::ResponseParsing:
+        return metrics.responseParsing;
+    case MetricsOperation::ResponseSerialization:
+        return metrics.responseSerialization;
+    }
+    detail::ensureNotReachable();
+}
+#endif
+} //namespace
+
+const Metrics& threadMetrics()
+{
+    return metricsStorage();
+}
+
+void resetThreadMetrics()
+{
+    metricsStorage() = Metrics{};
+}
+
+void setMetricsCallback(MetricsCallback callback)
+{
+    metricsCallback() = std::move(callback);
+}
+
+#ifdef HOT_TEACUP_ENABLE_METRICS
+namespace detail {
+
+MetricsScope::MetricsScope(MetricsOperation operation, std::size_t processedBytes)
+    : operation_{operation}
+    , processedBytes_{processedBytes}
+    , allocationCountOnStart_{allocationCounters.count}
+    , allocatedBytesOnStart_{allocationCounters.bytes}
+    , startTime_{std::chrono::steady_clock::now()}
+{
+}
+
+MetricsScope::~MetricsScope()
+{
+    const auto callMetrics = OperationMetrics{
+            1,
+            allocationCounters.count - allocationCountOnStart_,
+            allocationCounters.bytes - allocatedBytesOnStart_,
+            processedBytes_,
+            elementCount_,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime_)};
+
+    auto& metrics = operationMetrics(operation_);
+    metrics.callCount += callMetrics.callCount;
+    metrics.allocationCount += callMetrics.allocationCount;
+    metrics.allocatedBytes += callMetrics.allocatedBytes;
+    metrics.processedBytes += callMetrics.processedBytes;
+    metrics.elementCount += callMetrics.elementCount;
+    metrics.duration += callMetrics.duration;
+
+    //the callback runs in a destructor, possibly during stack unwinding, so its exceptions can't be propagated
+    if (const auto& callback = metricsCallback()) {
+        try {
+            callback(operation_, callMetrics);
+        }
+        catch (...) {
+        }
+    }
+}
+
+void MetricsScope::setProcessedBytes(std::size_t size)
+{
+    processedBytes_ = size;
+}
+
+void MetricsScope::setElementCount(std::size_t count)
+{
+    elementCount_ = count;
+}
+
+} //namespace detail
+#endif
+
+} //namespace http
+
+#ifdef HOT_TEACUP_ENABLE_METRICS
+void* operator new(std::size_t size)
+{
+    http::allocationCounters.count++;
+    http::allocationCounters.bytes += size;
+    if (auto ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+#endif
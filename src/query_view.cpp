@@ -27,21 +27,39 @@ bool operator==(const QueryView& lhs, const QueryView& rhs)
 
 std::vector<QueryView> queriesFromString(std::string_view input)
 {
+    return queriesFromString(input, ParseLimits{}).value();
+}
+
+ParseResult<std::vector<QueryView>> queriesFromString(std::string_view input, const ParseLimits& limits)
+{
+    if (input.size() > limits.maxTotalSize)
+        return ParseError{ParseErrorCode::LimitExceeded, limits.maxTotalSize};
+    if (input.empty())
+        return std::vector<QueryView>{};
+
+    //counting separators is a vectorized scan that makes the result vector grow only once
+    const auto queryCount = static_cast<std::size_t>(std::count(input.begin(), input.end(), '&')) + 1;
     auto result = std::vector<QueryView>{};
-    const auto queries = sfun::split(input, "&");
-    for (const auto& query : queries) {
-        const auto namePart = sfun::before(query, "=");
-        const auto valuePart = sfun::after(query, "=");
-        if (!namePart.has_value()) {
-            const auto name = sfun::trim(query);
-            if (!name.empty())
-                result.emplace_back(name, "");
-        }
-        else {
-            const auto name = sfun::trim(namePart.value());
-            if (!name.empty())
-                result.emplace_back(name, sfun::trim(valuePart.value_or("")));
+    result.reserve(std::min(queryCount, limits.maxFieldCount));
+    auto fieldCount = std::size_t{};
+    auto pos = std::size_t{};
+    while (pos < input.size()) {
+        if (++fieldCount > limits.maxFieldCount)
+            return ParseError{ParseErrorCode::LimitExceeded, pos};
+        const auto separatorPos = std::min(input.find('&', pos), input.size());
+        const auto query = sfun::trim(input.substr(pos, separatorPos - pos));
+        pos = separatorPos + 1;
+        if (query.empty())
+            continue;
+
+        const auto valueSeparatorPos = query.find('=');
+        if (valueSeparatorPos == std::string_view::npos) {
+            result.emplace_back(query, "");
+            continue;
         }
+        const auto name = sfun::trim(query.substr(0, valueSeparatorPos));
+        if (!name.empty())
+            result.emplace_back(name, sfun::trim(query.substr(valueSeparatorPos + 1)));
     }
     return result;
 }
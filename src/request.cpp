@@ -1,6 +1,7 @@
 #include <hot_teacup/request.h>
 #include <hot_teacup/request_view.h>
 #include <algorithm>
+#include <utility>
 
 using namespace std::string_literals;
 
@@ -15,6 +16,15 @@ Request::Request(const RequestView& requestView)
 {
 }
 
+Request::Request(const RequestView& requestView, const FormFileSpooling& fileSpooling)
+    : method_{requestView.method()}
+    , path_{requestView.path()}
+    , queries_{makeQueries(requestView.queries())}
+    , cookies_{makeCookies(requestView.cookies())}
+    , form_{makeForm(requestView.form(), fileSpooling)}
+{
+}
+
 Request::Request(
         RequestMethod method,
         std::string path,
@@ -29,24 +39,31 @@ Request::Request(
 {
 }
 
-void Request::setQueries(const std::vector<Query>& queries)
+void Request::setQueries(std::vector<Query> queries)
 {
-    queries_ = queries;
+    queries_ = std::move(queries);
 }
 
-void Request::setCookies(const std::vector<Cookie>& cookies)
+void Request::setCookies(std::vector<Cookie> cookies)
 {
-    cookies_ = cookies;
+    cookies_ = std::move(cookies);
 }
 
-void Request::setForm(const Form& form)
+void Request::setForm(Form form)
 {
-    form_ = form;
+    form_ = std::move(form);
 }
 
-void Request::setFcgiParams(const std::map<std::string, std::string>& params)
+void Request::setFcgiParams(std::map<std::string, std::string> params)
 {
-    fcgiParams_ = params;
+    fcgiParams_ = std::move(params);
+}
+
+Form Request::takeForm()
+{
+    auto result = std::move(form_);
+    form_.clear();
+    return result;
 }
 
 RequestMethod Request::method() const
@@ -194,6 +211,17 @@ const std::string& Request::fileType(std::string_view name, int index) const
     return valueNotFound;
 }
 
+const std::filesystem::path& Request::filePath(std::string_view name, int index) const
+{
+    auto i = 0;
+    for (const auto& [formFieldName, formField] : form_)
+        if (formField.hasFile() && formFieldName == name)
+            if (i++ == index)
+                return formField.filePath();
+
+    return pathNotFound;
+}
+
 const std::vector<Query>& Request::queries() const
 {
     return queries_;
@@ -0,0 +1,115 @@
+#include <hot_teacup/request_batch.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace http {
+
+namespace {
+RequestView makeRequestView(const RequestRecord& record)
+{
+    return RequestView{
+            record.fcgiParamRequestMethod,
+            record.fcgiParamRemoteAddr,
+            record.fcgiParamHttpHost,
+            record.fcgiParamRequestUri,
+            record.fcgiParamQueryString,
+            record.fcgiParamHttpCookie,
+            record.fcgiParamContentType,
+            record.fcgiStdIn};
+}
+
+std::size_t workerCount(std::size_t threadCount, std::size_t recordCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    return std::min(threadCount, recordCount);
+}
+
+/// Invokes visitor with every parsed request as an rvalue, so it can be either observed or taken over
+template<typename TVisitor>
+void processRecords(const std::vector<RequestRecord>& records, const TVisitor& visitor, std::size_t threadCount)
+{
+    const auto workers = workerCount(threadCount, records.size());
+    if (workers <= 1) {
+        for (auto i = std::size_t{}; i < records.size(); ++i)
+            visitor(i, makeRequestView(records[i]));
+        return;
+    }
+
+    const auto chunkSize = std::max<std::size_t>(records.size() / (workers * 8), 1);
+    auto nextRecord = std::atomic<std::size_t>{};
+    auto stopped = std::atomic<bool>{};
+    auto error = std::exception_ptr{};
+    auto errorMutex = std::mutex{};
+
+    auto work = [&]
+    {
+        while (!stopped) {
+            const auto chunkBegin = nextRecord.fetch_add(chunkSize);
+            if (chunkBegin >= records.size())
+                return;
+            const auto chunkEnd = std::min(chunkBegin + chunkSize, records.size());
+            try {
+                for (auto i = chunkBegin; i < chunkEnd; ++i)
+                    visitor(i, makeRequestView(records[i]));
+            }
+            catch (...) {
+                auto lock = std::lock_guard{errorMutex};
+                if (!error)
+                    error = std::current_exception();
+                stopped = true;
+            }
+        }
+    };
+
+    auto threads = std::vector<std::thread>{};
+    threads.reserve(workers - 1);
+    try {
+        for (auto i = std::size_t{1}; i < workers; ++i)
+            threads.emplace_back(work);
+    }
+    catch (...) {
+        //joinable threads can't be destroyed, the started ones are stopped and joined before rethrowing
+        stopped = true;
+        for (auto& thread : threads)
+            thread.join();
+        throw;
+    }
+    work();
+    for (auto& thread : threads)
+        thread.join();
+
+    if (error)
+        std::rethrow_exception(error);
+}
+} //namespace
+
+void visitRequests(const std::vector<RequestRecord>& records, const RequestVisitor& visitor, std::size_t threadCount)
+{
+    processRecords(records, visitor, threadCount);
+}
+
+std::vector<RequestView> parseRequests(const std::vector<RequestRecord>& records, std::size_t threadCount)
+{
+    auto parsedRequests = std::vector<std::optional<RequestView>>(records.size());
+    processRecords(
+            records,
+            [&parsedRequests](std::size_t recordIndex, RequestView&& request)
+            {
+                parsedRequests[recordIndex].emplace(std::move(request));
+            },
+            threadCount);
+
+    auto result = std::vector<RequestView>{};
+    result.reserve(parsedRequests.size());
+    for (auto& request : parsedRequests)
+        result.emplace_back(std::move(*request));
+    return result;
+}
+
+} //namespace http
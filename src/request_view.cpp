@@ -1,6 +1,8 @@
+#include "detail/metrics_scope.h"
 #include <hot_teacup/request_view.h>
 #include <sfun/string_utils.h>
 #include <algorithm>
+#include <array>
 
 using namespace std::string_literals;
 
@@ -15,6 +17,31 @@ RequestView::RequestView(
         std::string_view fcgiParamHttpCookie,
         std::string_view fcgiParamContentType,
         std::string_view fcgiStdIn)
+    : RequestView{
+              detail::MetricsScope{
+                      MetricsOperation::RequestViewParsing,
+                      fcgiParamQueryString.size() + fcgiParamHttpCookie.size() + fcgiStdIn.size()},
+              fcgiParamRequestMethod,
+              fcgiParamRemoteAddr,
+              fcgiParamHttpHost,
+              fcgiParamRequestUri,
+              fcgiParamQueryString,
+              fcgiParamHttpCookie,
+              fcgiParamContentType,
+              fcgiStdIn}
+{
+}
+
+RequestView::RequestView(
+        detail::MetricsScope&& metrics,
+        std::string_view fcgiParamRequestMethod,
+        std::string_view fcgiParamRemoteAddr,
+        std::string_view fcgiParamHttpHost,
+        std::string_view fcgiParamRequestUri,
+        std::string_view fcgiParamQueryString,
+        std::string_view fcgiParamHttpCookie,
+        std::string_view fcgiParamContentType,
+        std::string_view fcgiStdIn)
     : method_{methodFromString(fcgiParamRequestMethod)}
     , ipAddress_{fcgiParamRemoteAddr}
     , domainName_{sfun::before(fcgiParamHttpHost, ":").value_or(fcgiParamHttpHost)}
@@ -23,6 +50,46 @@ RequestView::RequestView(
     , cookies_{cookiesFromString(fcgiParamHttpCookie)}
     , form_{formFromString(fcgiParamContentType, fcgiStdIn)}
 {
+    metrics.setElementCount(queries_.size() + cookies_.size() + form_.size());
+}
+
+RequestView::RequestView(
+        std::string_view fcgiParamRequestMethod,
+        std::string_view fcgiParamRemoteAddr,
+        std::string_view fcgiParamHttpHost,
+        std::string_view fcgiParamRequestUri,
+        std::string_view fcgiParamQueryString,
+        std::string_view fcgiParamHttpCookie,
+        std::string_view fcgiParamContentType,
+        std::string_view fcgiStdIn,
+        const ParseLimits& limits)
+    : method_{methodFromString(fcgiParamRequestMethod)}
+    , ipAddress_{fcgiParamRemoteAddr}
+    , domainName_{sfun::before(fcgiParamHttpHost, ":").value_or(fcgiParamHttpHost)}
+    , path_{sfun::before(fcgiParamRequestUri, "?").value_or(fcgiParamRequestUri)}
+{
+    auto metrics = detail::MetricsScope{
+            MetricsOperation::RequestViewParsing,
+            fcgiParamQueryString.size() + fcgiParamHttpCookie.size() + fcgiStdIn.size()};
+    auto queries = queriesFromString(fcgiParamQueryString, limits);
+    if (!queries) {
+        parseError_ = ParseError{queries.error().code, queries.error().offset, ParseErrorSource::QueryString};
+        return;
+    }
+    auto cookies = cookiesFromString(fcgiParamHttpCookie, limits);
+    if (!cookies) {
+        parseError_ = ParseError{cookies.error().code, cookies.error().offset, ParseErrorSource::Cookies};
+        return;
+    }
+    auto form = formFromString(fcgiParamContentType, fcgiStdIn, limits);
+    if (!form) {
+        parseError_ = ParseError{form.error().code, form.error().offset, ParseErrorSource::Form};
+        return;
+    }
+    queries_ = std::move(*queries);
+    cookies_ = std::move(*cookies);
+    form_ = std::move(*form);
+    metrics.setElementCount(queries_.size() + cookies_.size() + form_.size());
 }
 
 RequestMethod RequestView::method() const
@@ -180,6 +247,51 @@ std::string_view RequestView::fileType(std::string_view name, int index) const
     return {};
 }
 
+namespace {
+RequestView makeRequestView(std::string_view buffer, const std::array<std::size_t, 8>& partSizes)
+{
+    auto pos = std::size_t{};
+    auto part = [&](std::size_t index)
+    {
+        const auto result = buffer.substr(pos, partSizes[index]);
+        pos += partSizes[index];
+        return result;
+    };
+    return RequestView{part(0), part(1), part(2), part(3), part(4), part(5), part(6), part(7)};
+}
+} //namespace
+
+SharedRequestView::SharedRequestView(
+        std::string_view fcgiParamRequestMethod,
+        std::string_view fcgiParamRemoteAddr,
+        std::string_view fcgiParamHttpHost,
+        std::string_view fcgiParamRequestUri,
+        std::string_view fcgiParamQueryString,
+        std::string_view fcgiParamHttpCookie,
+        std::string_view fcgiParamContentType,
+        std::string_view fcgiStdIn)
+    : detail::SharedBuffer{{
+              fcgiParamRequestMethod,
+              fcgiParamRemoteAddr,
+              fcgiParamHttpHost,
+              fcgiParamRequestUri,
+              fcgiParamQueryString,
+              fcgiParamHttpCookie,
+              fcgiParamContentType,
+              fcgiStdIn}}
+    , RequestView{makeRequestView(
+              sharedBuffer(),
+              {fcgiParamRequestMethod.size(),
+               fcgiParamRemoteAddr.size(),
+               fcgiParamHttpHost.size(),
+               fcgiParamRequestUri.size(),
+               fcgiParamQueryString.size(),
+               fcgiParamHttpCookie.size(),
+               fcgiParamContentType.size(),
+               fcgiStdIn.size()})}
+{
+}
+
 const std::vector<QueryView>& RequestView::queries() const
 {
     return queries_;
@@ -208,6 +320,11 @@ std::vector<std::string> RequestView::fileList() const
     return result;
 }
 
+const std::optional<ParseError>& RequestView::parseError() const
+{
+    return parseError_;
+}
+
 bool RequestView::hasFiles() const
 {
     return std::any_of(
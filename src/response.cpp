@@ -1,6 +1,12 @@
+#include "detail/metrics_scope.h"
 #include <hot_teacup/response.h>
+#include <hot_teacup/compression.h>
+#include <hot_teacup/http_date.h>
 #include <hot_teacup/response_view.h>
+#include <sfun/string_utils.h>
 #include <algorithm>
+#include <array>
+#include <charconv>
 #include <iterator>
 #include <utility>
 
@@ -16,30 +22,29 @@ Response::Response(const ResponseView& responseView)
 }
 
 Response::Response(ResponseStatus status, std::string body, std::vector<Cookie> cookies, std::vector<Header> headers)
+    : Response{status, std::move(body), std::move(cookies), std::move(headers), std::nullopt}
+{
+}
+
+Response::Response(
+        ResponseStatus status,
+        std::string body,
+        std::vector<Cookie> cookies,
+        std::vector<Header> headers,
+        std::optional<std::string> contentType)
     : status_{status}
     , body_{std::move(body)}
     , cookies_{std::move(cookies)}
     , headers_{std::move(headers)}
 {
-    if (!body_.empty()) {
-        if (std::find_if(
-                    headers_.begin(),
-                    headers_.end(),
-                    [](const Header& header)
-                    {
-                        return header.name() == "Content-Type";
-                    }) == headers_.end())
-            headers_.emplace_back("Content-Type", detail::contentTypeToString(ContentType::Html));
-    }
-}
+    for (const auto& header : headers_)
+        trackHeader(header);
 
-namespace {
-std::vector<Header> concatHeaders(std::vector<Header> lhs, const Header& rhs)
-{
-    lhs.push_back(rhs);
-    return lhs;
+    if (contentType)
+        addHeader({"Content-Type", std::move(*contentType)});
+    else if (!body_.empty() && !hasHeader(KnownHeader::ContentType))
+        addHeader({"Content-Type", detail::contentTypeToString(ContentType::Html)});
 }
-} //namespace
 
 Response::Response(
         ResponseStatus status,
@@ -47,11 +52,7 @@ Response::Response(
         std::string contentType,
         std::vector<Cookie> cookies,
         std::vector<Header> headers)
-    : Response{
-              status,
-              std::move(body),
-              std::move(cookies),
-              concatHeaders(std::move(headers), {"Content-Type", std::move(contentType)})}
+    : Response{status, std::move(body), std::move(cookies), std::move(headers), std::move(contentType)}
 {
 }
 
@@ -116,9 +117,16 @@ const std::vector<Header>& Response::headers() const
     return headers_;
 }
 
-void Response::setBody(const std::string& body)
+void Response::setBody(std::string body)
 {
-    body_ = body;
+    body_ = std::move(body);
+}
+
+std::string Response::takeBody()
+{
+    auto result = std::move(body_);
+    body_.clear();
+    return result;
 }
 
 void Response::addCookie(Cookie cookie)
@@ -128,17 +136,28 @@ void Response::addCookie(Cookie cookie)
 
 void Response::addHeader(Header header)
 {
+    trackHeader(header);
     headers_.emplace_back(std::move(header));
 }
 
-void Response::addCookies(const std::vector<Cookie>& cookies)
+void Response::addCookies(std::vector<Cookie> cookies)
 {
-    std::copy(cookies.begin(), cookies.end(), std::back_inserter(cookies_));
+    if (cookies_.empty()) {
+        cookies_ = std::move(cookies);
+        return;
+    }
+    cookies_.insert(cookies_.end(), std::make_move_iterator(cookies.begin()), std::make_move_iterator(cookies.end()));
 }
 
-void Response::addHeaders(const std::vector<Header>& headers)
+void Response::addHeaders(std::vector<Header> headers)
 {
-    std::copy(headers.begin(), headers.end(), std::back_inserter(headers_));
+    for (const auto& header : headers)
+        trackHeader(header);
+    if (headers_.empty()) {
+        headers_ = std::move(headers);
+        return;
+    }
+    headers_.insert(headers_.end(), std::make_move_iterator(headers.begin()), std::make_move_iterator(headers.end()));
 }
 
 std::string Response::statusData(ResponseMode mode) const
@@ -147,25 +166,218 @@ std::string Response::statusData(ResponseMode mode) const
             "\r\n";
 }
 
-std::string Response::cookiesData() const
+void Response::appendCookiesData(std::string& result) const
 {
-    auto result = std::string{};
-    for (const auto& cookie : cookies_)
-        result += cookie.toString() + "\r\n";
-    return result;
+    for (const auto& cookie : cookies_) {
+        result += cookie.toString();
+        result += "\r\n";
+    }
 }
 
-std::string Response::headersData() const
+void Response::appendHeadersData(std::string& result, std::optional<std::size_t> acceptEncodingVaryIndex) const
 {
-    auto result = std::string{};
-    for (auto& header : headers_)
-        result += header.toString() + "\r\n";
-    return result;
+    for (auto i = std::size_t{}; i < headers_.size(); ++i) {
+        if (i == acceptEncodingVaryIndex) {
+            //Vary is a plain list of header names, so only its value is kept
+            const auto& value = headers_[i].value();
+            result += Header{headers_[i].name(), value.empty() ? "Accept-Encoding" : value + ", Accept-Encoding"}
+                              .toString();
+        }
+        else
+            result += headers_[i].toString();
+        result += "\r\n";
+    }
+}
+
+namespace {
+std::optional<std::size_t> trackedHeaderBit(KnownHeader header)
+{
+    switch (header) {
+    case KnownHeader::ContentType:
+        return 0;
+    case KnownHeader::Location:
+        return 1;
+    case KnownHeader::ContentLength:
+        return 2;
+    case KnownHeader::Date:
+        return 3;
+    case KnownHeader::ContentEncoding:
+        return 4;
+    default:
+        return std::nullopt;
+    }
+}
+} //namespace
+
+void Response::trackHeader(const Header& header)
+{
+    const auto knownHeader = knownHeaderFromString(header.name());
+    if (!knownHeader)
+        return;
+    if (const auto bit = trackedHeaderBit(*knownHeader))
+        knownHeaders_.set(*bit);
+}
+
+bool Response::hasHeader(KnownHeader header) const
+{
+    const auto bit = trackedHeaderBit(header);
+    return bit && knownHeaders_.test(*bit);
+}
+
+std::optional<std::size_t> Response::findHeaderIndex(std::string_view name, std::size_t firstIndex) const
+{
+    for (auto i = firstIndex; i < headers_.size(); ++i)
+        if (detail::equalsCaseInsensitive(headers_[i].name(), name))
+            return i;
+    return std::nullopt;
 }
 
+void Response::eraseHeaders(std::string_view name, std::size_t firstIndex)
+{
+    auto outputIndex = firstIndex;
+    for (auto i = firstIndex; i < headers_.size(); ++i) {
+        if (detail::equalsCaseInsensitive(headers_[i].name(), name))
+            continue;
+        if (outputIndex != i)
+            headers_[outputIndex] = std::move(headers_[i]);
+        ++outputIndex;
+    }
+    headers_.erase(headers_.begin() + static_cast<std::ptrdiff_t>(outputIndex), headers_.end());
+}
+
+void Response::setHeader(Header header)
+{
+    const auto index = findHeaderIndex(header.name());
+    if (!index) {
+        addHeader(std::move(header));
+        return;
+    }
+    eraseHeaders(header.name(), *index + 1);
+    headers_[*index] = std::move(header);
+}
+
+void Response::removeHeader(std::string_view name)
+{
+    const auto index = findHeaderIndex(name);
+    if (!index)
+        return;
+    if (const auto knownHeader = knownHeaderFromString(name))
+        if (const auto bit = trackedHeaderBit(*knownHeader))
+            knownHeaders_.reset(*bit);
+    //the name can refer to the removed header
+    const auto nameCopy = std::string{name};
+    eraseHeaders(nameCopy, *index);
+}
+
+bool Response::varyListsAcceptEncoding() const
+{
+    for (auto index = findHeaderIndex("Vary"); index; index = findHeaderIndex("Vary", *index + 1)) {
+        const auto value = std::string_view{headers_[*index].value()};
+        auto pos = std::size_t{};
+        while (pos < value.size()) {
+            const auto separatorPos = std::min(value.find(',', pos), value.size());
+            const auto name = sfun::trim(value.substr(pos, separatorPos - pos));
+            pos = separatorPos + 1;
+            if (name == "*" || detail::equalsCaseInsensitive(name, "Accept-Encoding"))
+                return true;
+        }
+    }
+    return false;
+}
+
+const Header* Response::findHeader(std::string_view name) const
+{
+    const auto index = findHeaderIndex(name);
+    if (!index)
+        return nullptr;
+    return &headers_[*index];
+}
+
+namespace {
+/// 304 responses don't have a body, and a generated zero length would contradict
+/// the length of the representation they refer to
+bool statusAllowsContentLength(ResponseStatus status)
+{
+    switch (status) {
+    case ResponseStatus::_100_Continue:
+    case ResponseStatus::_101_Switching_Protocol:
+    case ResponseStatus::_102_Processing:
+    case ResponseStatus::_103_Early_Hints:
+    case ResponseStatus::_204_No_Content:
+    case ResponseStatus::_304_Not_Modified:
+        return false;
+    default:
+        return true;
+    }
+}
+
+void appendContentLength(std::string& result, std::size_t contentLength)
+{
+    auto buffer = std::array<char, 20>{};
+    const auto [end, error] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), contentLength);
+    result += "Content-Length: ";
+    result.append(buffer.data(), static_cast<std::size_t>(end - buffer.data()));
+    result += "\r\n";
+}
+
+void appendDate(std::string& result)
+{
+    result += "Date: ";
+    result += currentHttpDate();
+    result += "\r\n";
+}
+
+void appendContentEncoding(std::string& result, ContentEncoding encoding, bool addVary)
+{
+    result += "Content-Encoding: ";
+    result += detail::contentEncodingToString(encoding);
+    result += "\r\n";
+    if (addVary)
+        result += "Vary: Accept-Encoding\r\n";
+}
+
+} //namespace
+
 std::string Response::data(ResponseMode mode) const
 {
-    return statusData(mode) + headersData() + cookiesData() + "\r\n" + body_;
+    return data(mode, ResponseDataOptions{false, false});
+}
+
+std::string Response::data(ResponseMode mode, const ResponseDataOptions& options) const
+{
+    auto metrics = detail::MetricsScope{MetricsOperation::ResponseSerialization};
+    const auto addContentLength =
+            options.contentLength && statusAllowsContentLength(status_) && !hasHeader(KnownHeader::ContentLength);
+    const auto addDate = options.date && !hasHeader(KnownHeader::Date);
+    const auto compressBody = compressionEnabled() && options.contentEncoding != ContentEncoding::Identity &&
+            body_.size() >= options.compressionThreshold && !body_.empty() &&
+            !hasHeader(KnownHeader::ContentEncoding) && !hasHeader(KnownHeader::ContentLength);
+
+    auto compressedBody = std::string{};
+    if (compressBody)
+        compress(body_, options.contentEncoding, compressedBody, options.compressionLevel);
+    const auto& body = compressBody ? compressedBody : body_;
+
+    auto result = statusData(mode);
+    //Accept-Encoding is added to the response's own Vary header if it has one
+    const auto varyIndex = compressBody ? findHeaderIndex("Vary") : std::nullopt;
+    const auto acceptEncodingVaryIndex =
+            varyIndex && !varyListsAcceptEncoding() ? varyIndex : std::optional<std::size_t>{};
+    appendHeadersData(result, acceptEncodingVaryIndex);
+    if (compressBody)
+        appendContentEncoding(result, options.contentEncoding, !varyIndex);
+    if (addContentLength)
+        appendContentLength(result, body.size());
+    if (addDate)
+        appendDate(result);
+    appendCookiesData(result);
+    result.reserve(result.size() + 2 + body.size());
+    result += "\r\n";
+    result += body;
+
+    metrics.setProcessedBytes(result.size());
+    metrics.setElementCount(cookies_.size() + headers_.size());
+    return result;
 }
 
 } //namespace http
@@ -0,0 +1,179 @@
+#include <hot_teacup/request_view.h>
+#include <hot_teacup/response.h>
+#include <hot_teacup/response_cache.h>
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace http {
+
+namespace detail {
+struct ResponseCacheStripe {
+    struct Key {
+        ResponseMode mode;
+        std::string value;
+    };
+    struct Entry {
+        std::shared_ptr<const std::string> data;
+        std::chrono::steady_clock::time_point expirationTime;
+        std::list<Key>::iterator keyIt;
+    };
+    /// Map keys refer to the strings stored in the keys list
+    using EntryMap = std::unordered_map<std::string_view, Entry>;
+
+    EntryMap& entries(ResponseMode mode)
+    {
+        return entriesByMode[mode == ResponseMode::Http ? 0 : 1];
+    }
+
+    void erase(EntryMap& modeEntries, EntryMap::iterator entryIt)
+    {
+        totalSize -= entryIt->first.size() + entryIt->second.data->size();
+        const auto keyIt = entryIt->second.keyIt;
+        modeEntries.erase(entryIt);
+        keys.erase(keyIt);
+    }
+
+    void eraseOldest()
+    {
+        auto& modeEntries = entries(keys.front().mode);
+        erase(modeEntries, modeEntries.find(keys.front().value));
+    }
+
+    mutable std::shared_mutex mutex;
+    /// Stored keys, from the oldest to the newest
+    std::list<Key> keys;
+    std::array<EntryMap, 2> entriesByMode;
+    std::size_t totalSize = 0;
+};
+} //namespace detail
+
+namespace {
+std::size_t divideRoundingUp(std::size_t value, std::size_t divisor)
+{
+    return value / divisor + (value % divisor ? 1 : 0);
+}
+} //namespace
+
+ResponseCache::ResponseCache(ResponseCacheOptions options)
+    : options_{options}
+{
+    options_.stripeCount = std::max(options_.stripeCount, std::size_t{1});
+    options_.maxEntryCount = divideRoundingUp(options_.maxEntryCount, options_.stripeCount);
+    options_.maxTotalSize = divideRoundingUp(options_.maxTotalSize, options_.stripeCount);
+    for (auto i = std::size_t{}; i < options_.stripeCount; ++i)
+        stripes_.emplace_back(std::make_unique<detail::ResponseCacheStripe>());
+}
+
+ResponseCache::~ResponseCache() = default;
+
+detail::ResponseCacheStripe& ResponseCache::stripe(std::string_view key) const
+{
+    return *stripes_[std::hash<std::string_view>{}(key) % stripes_.size()];
+}
+
+std::shared_ptr<const std::string> ResponseCache::find(std::string_view key, ResponseMode mode) const
+{
+    auto& keyStripe = stripe(key);
+    auto lock = std::shared_lock{keyStripe.mutex};
+    const auto& entries = keyStripe.entries(mode);
+    const auto entryIt = entries.find(key);
+    if (entryIt == entries.end() || entryIt->second.expirationTime <= std::chrono::steady_clock::now())
+        return nullptr;
+    return entryIt->second.data;
+}
+
+std::shared_ptr<const std::string> ResponseCache::store(
+        std::string_view key,
+        std::string responseData,
+        ResponseMode mode)
+{
+    auto data = std::make_shared<const std::string>(std::move(responseData));
+    const auto entrySize = key.size() + data->size();
+    if (options_.maxEntryCount == 0 || entrySize > options_.maxTotalSize)
+        return data;
+
+    const auto now = std::chrono::steady_clock::now();
+    auto& keyStripe = stripe(key);
+    auto lock = std::unique_lock{keyStripe.mutex};
+    auto& entries = keyStripe.entries(mode);
+    if (const auto entryIt = entries.find(key); entryIt != entries.end())
+        keyStripe.erase(entries, entryIt);
+
+    //all entries have the same time to live, so the oldest ones expire first
+    while (!keyStripe.keys.empty()) {
+        const auto& oldestEntry = keyStripe.entries(keyStripe.keys.front().mode).at(keyStripe.keys.front().value);
+        const auto isFull = keyStripe.keys.size() >= options_.maxEntryCount ||
+                keyStripe.totalSize + entrySize > options_.maxTotalSize;
+        if (!isFull && oldestEntry.expirationTime > now)
+            break;
+        keyStripe.eraseOldest();
+    }
+
+    keyStripe.keys.push_back({mode, std::string{key}});
+    const auto keyIt = std::prev(keyStripe.keys.end());
+    entries.emplace(keyIt->value, detail::ResponseCacheStripe::Entry{data, now + options_.timeToLive, keyIt});
+    keyStripe.totalSize += entrySize;
+    return data;
+}
+
+std::shared_ptr<const std::string> ResponseCache::store(
+        std::string_view key,
+        const Response& response,
+        ResponseMode mode)
+{
+    return store(key, response.data(mode), mode);
+}
+
+void ResponseCache::remove(std::string_view key)
+{
+    auto& keyStripe = stripe(key);
+    auto lock = std::unique_lock{keyStripe.mutex};
+    for (auto& entries : keyStripe.entriesByMode)
+        if (const auto entryIt = entries.find(key); entryIt != entries.end())
+            keyStripe.erase(entries, entryIt);
+}
+
+void ResponseCache::clear()
+{
+    for (auto& keyStripe : stripes_) {
+        auto lock = std::unique_lock{keyStripe->mutex};
+        for (auto& entries : keyStripe->entriesByMode)
+            entries.clear();
+        keyStripe->keys.clear();
+        keyStripe->totalSize = 0;
+    }
+}
+
+std::size_t ResponseCache::size() const
+{
+    auto result = std::size_t{};
+    for (const auto& keyStripe : stripes_) {
+        auto lock = std::shared_lock{keyStripe->mutex};
+        result += keyStripe->keys.size();
+    }
+    return result;
+}
+
+std::string responseCacheKey(const RequestView& request, const std::vector<std::string_view>& queryNames)
+{
+    //'\0' can't appear in the path or in queries, so different requests can't produce the same key
+    auto result = std::string{request.path()};
+    for (const auto name : queryNames) {
+        result += '\0';
+        result += name;
+        if (request.hasQuery(name)) {
+            result += '=';
+            result += request.query(name);
+        }
+    }
+    return result;
+}
+
+} //namespace http
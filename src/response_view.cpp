@@ -1,3 +1,4 @@
+#include "detail/metrics_scope.h"
 #include <hot_teacup/response_view.h>
 #include <algorithm>
 #include <regex>
@@ -38,6 +39,12 @@ const std::vector<HeaderView>& ResponseView::headers() const
     return headers_;
 }
 
+SharedResponseView::SharedResponseView(std::shared_ptr<const std::string> buffer, ResponseView responseView)
+    : detail::SharedBuffer{std::move(buffer)}
+    , ResponseView{std::move(responseView)}
+{
+}
+
 namespace {
 template<ResponseMode mode>
 auto makeStatusRegex()
@@ -77,24 +84,42 @@ std::string_view getStringLine(std::string_view input, std::size_t& pos, std::st
 
 std::optional<ResponseView> responseFromString(std::string_view data, ResponseMode mode)
 {
+    auto result = responseFromString(data, mode, ParseLimits{});
+    if (!result)
+        return std::nullopt;
+    return std::move(*result);
+}
+
+ParseResult<ResponseView> responseFromString(std::string_view data, ResponseMode mode, const ParseLimits& limits)
+{
+    auto metrics = detail::MetricsScope{MetricsOperation::ResponseParsing, data.size()};
+    if (data.size() > limits.maxTotalSize)
+        return ParseError{ParseErrorCode::LimitExceeded, limits.maxTotalSize};
+
     auto pos = std::size_t{};
     auto statusLine = getStringLine(data, pos);
+    if (statusLine.size() > limits.maxHeaderLineLength)
+        return ParseError{ParseErrorCode::LimitExceeded, limits.maxHeaderLineLength};
     auto status = (mode == ResponseMode::Http) ? statusCodeFromString<ResponseMode::Http>(std::string{statusLine})
                                                : statusCodeFromString<ResponseMode::Cgi>(std::string{statusLine});
     if (status == std::nullopt)
-        return std::nullopt;
+        return ParseError{ParseErrorCode::InvalidStatusLine, 0};
 
     auto cookies = std::vector<CookieView>{};
     auto headers = std::vector<HeaderView>{};
+    auto headerCount = std::size_t{};
     while (true) {
+        const auto headerLinePos = pos;
         auto headerLine = getStringLine(data, pos);
         if (headerLine.empty())
             break;
+        if (++headerCount > limits.maxFieldCount)
+            return ParseError{ParseErrorCode::LimitExceeded, headerLinePos};
 
-        auto header = headerFromString(headerLine);
-        if (header == std::nullopt)
-            return std::nullopt;
-        if (header->name() == "Set-Cookie") {
+        auto header = headerFromString(headerLine, limits);
+        if (!header)
+            return ParseError{header.error().code, headerLinePos + header.error().offset};
+        if (knownHeaderFromString(header->name()) == KnownHeader::SetCookie) {
             auto cookie = cookieFromHeader(*header);
             if (cookie)
                 cookies.emplace_back(std::move(*cookie));
@@ -103,7 +128,17 @@ std::optional<ResponseView> responseFromString(std::string_view data, ResponseMo
             headers.emplace_back(*header);
     }
     auto body = data.substr(pos, data.size() - pos);
+    metrics.setElementCount(cookies.size() + headers.size());
     return ResponseView{*status, body, std::move(cookies), std::move(headers)};
 }
 
+std::optional<SharedResponseView> sharedResponseFromString(std::string_view data, ResponseMode mode)
+{
+    auto buffer = std::make_shared<const std::string>(data);
+    auto responseView = responseFromString(*buffer, mode);
+    if (!responseView)
+        return std::nullopt;
+    return SharedResponseView{std::move(buffer), std::move(*responseView)};
+}
+
 } //namespace http
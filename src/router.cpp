@@ -0,0 +1,189 @@
+#include <hot_teacup/request_view.h>
+#include <hot_teacup/router.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace http {
+
+std::size_t RouteMatch::routeId() const
+{
+    return routeId_;
+}
+
+std::string_view RouteMatch::param(std::string_view name) const
+{
+    for (auto i = std::size_t{}; i < paramNames_->size(); ++i)
+        if ((*paramNames_)[i] == name)
+            return paramValues_[i];
+    return {};
+}
+
+std::string_view RouteMatch::param(std::size_t index) const
+{
+    if (index >= paramCount())
+        return {};
+    return paramValues_[index];
+}
+
+std::size_t RouteMatch::paramCount() const
+{
+    return paramNames_->size();
+}
+
+std::string_view RouteMatch::wildcard() const
+{
+    return wildcard_;
+}
+
+namespace {
+/// Returns the path without the leading '/', or an empty optional if the path has no segments
+std::optional<std::string_view> pathSegments(std::string_view path)
+{
+    if (!path.empty() && path.front() == '/')
+        path.remove_prefix(1);
+    if (path.empty())
+        return std::nullopt;
+    return path;
+}
+
+std::pair<std::string_view, std::optional<std::string_view>> splitFirstSegment(std::string_view path)
+{
+    const auto separatorPos = path.find('/');
+    if (separatorPos == std::string_view::npos)
+        return {path, std::nullopt};
+    return {path.substr(0, separatorPos), path.substr(separatorPos + 1)};
+}
+
+std::invalid_argument invalidPattern(std::string_view pattern, std::string_view reason)
+{
+    return std::invalid_argument{"Route pattern '" + std::string{pattern} + "' " + std::string{reason}};
+}
+} //namespace
+
+Router::Router()
+    : nodes_(1)
+{
+}
+
+std::size_t Router::literalChild(std::size_t nodeIndex, std::string_view segment)
+{
+    auto& children = nodes_[nodeIndex].literalChildren;
+    const auto childIt = std::lower_bound(
+            children.begin(),
+            children.end(),
+            segment,
+            [](const auto& child, std::string_view value)
+            {
+                return child.first < value;
+            });
+    if (childIt != children.end() && childIt->first == segment)
+        return childIt->second;
+
+    const auto childIndex = nodes_.size();
+    children.emplace(childIt, std::string{segment}, childIndex);
+    nodes_.emplace_back();
+    return childIndex;
+}
+
+std::size_t Router::paramChild(std::size_t nodeIndex)
+{
+    if (const auto childIndex = nodes_[nodeIndex].paramChild)
+        return *childIndex;
+
+    const auto childIndex = nodes_.size();
+    nodes_[nodeIndex].paramChild = childIndex;
+    nodes_.emplace_back();
+    return childIndex;
+}
+
+std::size_t Router::addRoute(std::string_view pattern)
+{
+    const auto routeId = routeParamNames_.size();
+    auto paramNames = std::vector<std::string>{};
+    auto nodeIndex = std::size_t{};
+    auto isWildcard = false;
+
+    auto path = pathSegments(pattern);
+    while (path) {
+        const auto [segment, nextPath] = splitFirstSegment(*path);
+        path = nextPath;
+        if (segment == "*") {
+            if (path)
+                throw invalidPattern(pattern, "can contain the wildcard only as the last segment");
+            isWildcard = true;
+        }
+        else if (segment.size() > 2 && segment.front() == '{' && segment.back() == '}') {
+            if (paramNames.size() == RouteMatch::maxParamCount)
+                throw invalidPattern(pattern, "contains too many parameters");
+            paramNames.emplace_back(segment.substr(1, segment.size() - 2));
+            nodeIndex = paramChild(nodeIndex);
+        }
+        else if (segment.find_first_of("{}*") != std::string_view::npos)
+            throw invalidPattern(pattern, "contains a malformed segment '" + std::string{segment} + "'");
+        else
+            nodeIndex = literalChild(nodeIndex, segment);
+    }
+
+    auto& routeIdSlot = isWildcard ? nodes_[nodeIndex].wildcardRouteId : nodes_[nodeIndex].routeId;
+    if (routeIdSlot)
+        throw invalidPattern(pattern, "duplicates an existing route");
+    routeIdSlot = routeId;
+    routeParamNames_.emplace_back(std::move(paramNames));
+    return routeId;
+}
+
+bool Router::matchSegments(
+        const Node& node,
+        std::optional<std::string_view> path,
+        RouteMatch& result,
+        std::size_t paramCount) const
+{
+    if (!path) {
+        if (!node.routeId)
+            return false;
+        result.routeId_ = *node.routeId;
+        return true;
+    }
+
+    const auto [segment, nextPath] = splitFirstSegment(*path);
+    const auto childIt = std::lower_bound(
+            node.literalChildren.begin(),
+            node.literalChildren.end(),
+            segment,
+            [](const auto& child, std::string_view value)
+            {
+                return child.first < value;
+            });
+    if (childIt != node.literalChildren.end() && childIt->first == segment &&
+        matchSegments(nodes_[childIt->second], nextPath, result, paramCount))
+        return true;
+
+    if (node.paramChild && !segment.empty()) {
+        result.paramValues_[paramCount] = segment;
+        if (matchSegments(nodes_[*node.paramChild], nextPath, result, paramCount + 1))
+            return true;
+    }
+
+    if (node.wildcardRouteId) {
+        result.routeId_ = *node.wildcardRouteId;
+        result.wildcard_ = *path;
+        return true;
+    }
+    return false;
+}
+
+std::optional<RouteMatch> Router::match(std::string_view path) const
+{
+    auto result = RouteMatch{};
+    if (!matchSegments(nodes_.front(), pathSegments(path), result, 0))
+        return std::nullopt;
+    result.paramNames_ = &routeParamNames_[result.routeId_];
+    return result;
+}
+
+std::optional<RouteMatch> Router::match(const RequestView& request) const
+{
+    return match(request.path());
+}
+
+} //namespace http
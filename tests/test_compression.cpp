@@ -0,0 +1,184 @@
+#include <hot_teacup/compression.h>
+#include <hot_teacup/response.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#ifdef HOT_TEACUP_ENABLE_COMPRESSION
+#include <zlib.h>
+#endif
+
+namespace {
+
+#ifdef HOT_TEACUP_ENABLE_COMPRESSION
+std::string decompress(std::string_view data, http::ContentEncoding encoding)
+{
+    auto stream = z_stream{};
+    const auto windowBits = encoding == http::ContentEncoding::Gzip ? 15 + 16 : 15;
+    if (inflateInit2(&stream, windowBits) != Z_OK)
+        return {};
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    auto result = std::string{};
+    auto buffer = std::string(4096, '\0');
+    auto status = Z_OK;
+    while (status == Z_OK) {
+        stream.next_out = reinterpret_cast<Bytef*>(buffer.data());
+        stream.avail_out = static_cast<uInt>(buffer.size());
+        status = inflate(&stream, Z_NO_FLUSH);
+        result.append(buffer.data(), buffer.size() - stream.avail_out);
+    }
+    inflateEnd(&stream);
+    if (status != Z_STREAM_END)
+        return {};
+    return result;
+}
+
+std::string testContent()
+{
+    auto result = std::string{};
+    for (auto i = 0; i < 1000; ++i)
+        result += R"({"id":)" + std::to_string(i) + R"(,"name":"hot_teacup"},)";
+    return result;
+}
+#endif
+
+} //namespace
+
+TEST(Compression, NegotiateContentEncoding)
+{
+    if (!http::compressionEnabled()) {
+        EXPECT_EQ(http::negotiateContentEncoding("gzip, deflate"), http::ContentEncoding::Identity);
+        return;
+    }
+    EXPECT_EQ(http::negotiateContentEncoding("gzip, deflate, br"), http::ContentEncoding::Gzip);
+    EXPECT_EQ(http::negotiateContentEncoding("deflate, gzip"), http::ContentEncoding::Gzip);
+    EXPECT_EQ(http::negotiateContentEncoding("deflate"), http::ContentEncoding::Deflate);
+    EXPECT_EQ(http::negotiateContentEncoding("GZIP;q=0.5, deflate;Q=0.8"), http::ContentEncoding::Deflate);
+    EXPECT_EQ(http::negotiateContentEncoding("x-gzip"), http::ContentEncoding::Gzip);
+    EXPECT_EQ(http::negotiateContentEncoding("*"), http::ContentEncoding::Gzip);
+    EXPECT_EQ(http::negotiateContentEncoding("gzip;q=0, *;q=0.3"), http::ContentEncoding::Deflate);
+    EXPECT_EQ(http::negotiateContentEncoding("gzip;q=0, deflate;q=0.000"), http::ContentEncoding::Identity);
+    EXPECT_EQ(http::negotiateContentEncoding("gzip;q=2, br"), http::ContentEncoding::Identity);
+    EXPECT_EQ(http::negotiateContentEncoding("identity"), http::ContentEncoding::Identity);
+    EXPECT_EQ(http::negotiateContentEncoding(""), http::ContentEncoding::Identity);
+}
+
+TEST(Compression, IdentityEncoding)
+{
+    auto output = std::string{"data: "};
+    http::compress("Hello world", http::ContentEncoding::Identity, output);
+    EXPECT_EQ(output, "data: Hello world");
+}
+
+#ifdef HOT_TEACUP_ENABLE_COMPRESSION
+TEST(Compression, Compress)
+{
+    const auto content = testContent();
+    for (auto encoding : {http::ContentEncoding::Gzip, http::ContentEncoding::Deflate}) {
+        for (auto level : {http::defaultCompressionLevel, 1, 9}) {
+            auto output = std::string{};
+            http::compress(content, encoding, output, level);
+            EXPECT_LT(output.size(), content.size() / 5);
+            EXPECT_EQ(decompress(output, encoding), content);
+        }
+    }
+}
+
+TEST(Compression, CompressionStream)
+{
+    const auto content = testContent();
+    auto stream = http::CompressionStream{http::ContentEncoding::Gzip};
+    auto output = std::string{};
+    for (auto pos = std::size_t{}; pos < content.size(); pos += 1000)
+        stream.write(std::string_view{content}.substr(pos, 1000), output);
+    stream.finish(output);
+    EXPECT_EQ(decompress(output, http::ContentEncoding::Gzip), content);
+}
+
+TEST(Compression, ResponseData)
+{
+    const auto content = testContent();
+    const auto response = http::Response{content, http::ContentType::Json};
+    auto options = http::ResponseDataOptions{};
+    options.contentEncoding = http::negotiateContentEncoding("gzip");
+
+    const auto data = response.data(http::ResponseMode::Http, options);
+    const auto headersEnd = data.find("\r\n\r\n");
+    ASSERT_NE(headersEnd, std::string::npos);
+    const auto body = data.substr(headersEnd + 4);
+    EXPECT_EQ(
+            data.substr(0, headersEnd + 4),
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Type: application/json\r\n"
+            "Content-Encoding: gzip\r\n"
+            "Vary: Accept-Encoding\r\n"
+            "Content-Length: " +
+                    std::to_string(body.size()) + "\r\n\r\n");
+    EXPECT_EQ(decompress(body, http::ContentEncoding::Gzip), content);
+}
+
+TEST(Compression, ResponseDataWithVary)
+{
+    const auto content = testContent();
+    auto options = http::ResponseDataOptions{};
+    options.contentLength = false;
+    options.contentEncoding = http::ContentEncoding::Gzip;
+    const auto headers = [&](const http::Response& response)
+    {
+        const auto data = response.data(http::ResponseMode::Http, options);
+        return data.substr(0, data.find("\r\n\r\n") + 4);
+    };
+
+    auto response = http::Response{content, http::ContentType::Json};
+    response.addHeader(http::Header{"Vary", "Origin"});
+    EXPECT_EQ(
+            headers(response),
+            "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nVary: Origin, Accept-Encoding\r\n"
+            "Content-Encoding: gzip\r\n\r\n");
+
+    response.addHeader(http::Header{"Vary", "Cookie, accept-encoding"});
+    EXPECT_EQ(
+            headers(response),
+            "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nVary: Origin\r\nVary: Cookie, accept-encoding\r\n"
+            "Content-Encoding: gzip\r\n\r\n");
+
+    response.setHeader(http::Header{"Vary", "*"});
+    EXPECT_EQ(
+            headers(response),
+            "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nVary: *\r\nContent-Encoding: gzip\r\n\r\n");
+}
+
+TEST(Compression, InvalidLevel)
+{
+    const auto content = testContent();
+    auto output = std::string{};
+    http::compress(content, http::ContentEncoding::Gzip, output);
+    EXPECT_THROW(http::compress(content, http::ContentEncoding::Gzip, output, 42), std::runtime_error);
+
+    output.clear();
+    http::compress(content, http::ContentEncoding::Gzip, output);
+    EXPECT_EQ(decompress(output, http::ContentEncoding::Gzip), content);
+}
+#endif
+
+TEST(Compression, ResponseDataBelowThreshold)
+{
+    const auto response = http::Response{"Hello world", http::ContentType::PlainText};
+    auto options = http::ResponseDataOptions{};
+    options.contentEncoding = http::ContentEncoding::Gzip;
+    EXPECT_EQ(
+            response.data(http::ResponseMode::Http, options),
+            "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: 11\r\n\r\nHello world");
+}
+
+TEST(Compression, ResponseDataWithContentLength)
+{
+    const auto content = std::string(2048, 'a');
+    auto response = http::Response{content, http::ContentType::PlainText};
+    response.addHeader(http::Header{"Content-Length", "2048"});
+    auto options = http::ResponseDataOptions{};
+    options.contentEncoding = http::ContentEncoding::Gzip;
+    EXPECT_EQ(
+            response.data(http::ResponseMode::Http, options),
+            "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: 2048\r\n\r\n" + content);
+}
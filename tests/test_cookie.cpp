@@ -136,6 +136,25 @@ TEST(CookieView, FromString)
     }
 }
 
+TEST(CookieView, RequestCookiesFromString)
+{
+    const auto cookies = http::cookiesFromString(" session = abc=def ; flag; theme=dark ;");
+    const auto expectedCookies = std::vector<http::CookieView>{{"session", " abc=def"}, {"theme", "dark"}};
+    EXPECT_EQ(cookies, expectedCookies);
+
+    const auto& cookie = cookies.at(1);
+    EXPECT_EQ(cookie.domain(), std::nullopt);
+    EXPECT_EQ(cookie.maxAge(), std::nullopt);
+    EXPECT_FALSE(cookie.isSecure());
+    EXPECT_FALSE(cookie.isRemoved());
+    const auto header = cookie.asHeader();
+    EXPECT_EQ(header.name(), "Set-Cookie");
+    ASSERT_EQ(header.params().size(), 1);
+    EXPECT_EQ(header.params().at(0).name(), "theme");
+    EXPECT_EQ(header.params().at(0).value(), "dark");
+    EXPECT_EQ(http::Cookie{cookie}.toString(), "Set-Cookie: theme=dark");
+}
+
 TEST(CookieView, FromHeader)
 {
     {
@@ -161,6 +180,151 @@ TEST(CookieView, FromHeader)
     }
 }
 
+TEST(CookieView, FromHeaderWithLowercaseAttributes)
+{
+    const auto header = http::headerFromString("Set-Cookie: foo=bar; max-age=10; domain=localhost; path=/test");
+    ASSERT_TRUE(header);
+    const auto cookie = http::cookieFromHeader(*header);
+    ASSERT_TRUE(cookie);
+    EXPECT_EQ(cookie->maxAge(), std::chrono::seconds{10});
+    EXPECT_EQ(cookie->domain(), "localhost");
+    EXPECT_EQ(cookie->path(), "/test");
+}
+
+TEST(Cookie, ToStringWithAllAttributes)
+{
+    auto cookie = http::Cookie{"foo", "bar"};
+    cookie.setPath("/");
+    cookie.setExpires("Wed, 21 Oct 2015 07:28:00 GMT");
+    cookie.setSecure();
+    cookie.setHttpOnly();
+    cookie.setSameSite(http::CookieSameSite::None);
+    cookie.setPartitioned();
+    EXPECT_EQ(
+            cookie.toString(),
+            "Set-Cookie: foo=bar; Path=/; Expires=Wed, 21 Oct 2015 07:28:00 GMT; Secure; HttpOnly; SameSite=None; "
+            "Partitioned");
+    EXPECT_EQ(cookie.expires(), "Wed, 21 Oct 2015 07:28:00 GMT");
+    EXPECT_EQ(cookie.sameSite(), http::CookieSameSite::None);
+    EXPECT_TRUE(cookie.isHttpOnly());
+    EXPECT_TRUE(cookie.isPartitioned());
+}
+
+TEST(Cookie, OverwriteStringAttributes)
+{
+    auto cookie = http::Cookie{"foo", "bar"};
+    EXPECT_FALSE(cookie.domain());
+    EXPECT_FALSE(cookie.path());
+    EXPECT_FALSE(cookie.expires());
+    cookie.setExpires("Wed, 21 Oct 2015 07:28:00 GMT");
+    cookie.setPath("/");
+    cookie.setDomain("example.com");
+    cookie.setPath("/very/long/path/to/the/resource");
+    cookie.setDomain("");
+    EXPECT_EQ(cookie.domain(), "");
+    EXPECT_EQ(cookie.path(), "/very/long/path/to/the/resource");
+    EXPECT_EQ(cookie.expires(), "Wed, 21 Oct 2015 07:28:00 GMT");
+
+    cookie.setExpires("Thu, 01 Jan 1970 00:00:00 GMT");
+    cookie.setPath("/");
+    EXPECT_EQ(
+            cookie.toString(),
+            "Set-Cookie: foo=bar; Expires=Thu, 01 Jan 1970 00:00:00 GMT; Path=/; Domain=");
+}
+
+TEST(Cookie, FromTemplate)
+{
+    auto prototype = http::Cookie{"prototype", ""};
+    prototype.setPath("/");
+    prototype.setSecure();
+    prototype.setHttpOnly();
+    prototype.setSameSite(http::CookieSameSite::Lax);
+    const auto cookieTemplate = http::CookieTemplate{prototype};
+
+    {
+        const auto cookie = cookieTemplate.makeCookie("foo", "bar");
+        EXPECT_EQ(cookie.toString(), "Set-Cookie: foo=bar; Path=/; Secure; HttpOnly; SameSite=Lax");
+        EXPECT_EQ(cookie.name(), "foo");
+        EXPECT_EQ(cookie.value(), "bar");
+        EXPECT_EQ(cookie.path(), "/");
+        EXPECT_EQ(cookie.domain(), std::nullopt);
+        EXPECT_EQ(cookie.sameSite(), http::CookieSameSite::Lax);
+        EXPECT_TRUE(cookie.isSecure());
+        EXPECT_TRUE(cookie.isHttpOnly());
+        EXPECT_FALSE(cookie.isPartitioned());
+    }
+    {
+        auto cookie = cookieTemplate.makeCookie("foo", "bar");
+        cookie.setMaxAge(std::chrono::seconds{10});
+        cookie.setPath("/test");
+        EXPECT_EQ(
+                cookie.toString(),
+                "Set-Cookie: foo=bar; Secure; HttpOnly; SameSite=Lax; Max-Age=10; Path=/test");
+        EXPECT_EQ(cookie.path(), "/test");
+        EXPECT_EQ(cookie.maxAge(), std::chrono::seconds{10});
+    }
+    {
+        auto derivedPrototype = cookieTemplate.makeCookie("prototype", "");
+        derivedPrototype.setMaxAge(std::chrono::seconds{3600});
+        derivedPrototype.setSameSite(http::CookieSameSite::Strict);
+        const auto derivedTemplate = http::CookieTemplate{derivedPrototype};
+        auto cookie = derivedTemplate.makeCookie("foo", "bar");
+        cookie.setRemoved();
+        EXPECT_EQ(cookie.toString(), "Set-Cookie: foo=bar; Path=/; Secure; HttpOnly; SameSite=Strict; Max-Age=0");
+        EXPECT_TRUE(cookie.isRemoved());
+    }
+}
+
+TEST(CookieView, FromHeaderStringWithAllAttributes)
+{
+    const auto header = http::headerFromString(
+            "Set-Cookie: foo=bar; Expires=Wed, 21 Oct 2015 07:28:00 GMT; HttpOnly; samesite=strict; Partitioned");
+    ASSERT_TRUE(header);
+    const auto cookie = http::cookieFromHeader(*header);
+    ASSERT_TRUE(cookie);
+    EXPECT_EQ(cookie->expires(), "Wed, 21 Oct 2015 07:28:00 GMT");
+    EXPECT_EQ(cookie->sameSite(), http::CookieSameSite::Strict);
+    EXPECT_TRUE(cookie->isHttpOnly());
+    EXPECT_TRUE(cookie->isPartitioned());
+    EXPECT_FALSE(cookie->isSecure());
+
+    const auto ownedCookie = http::Cookie{*cookie};
+    EXPECT_EQ(ownedCookie.expires(), "Wed, 21 Oct 2015 07:28:00 GMT");
+    EXPECT_EQ(ownedCookie.sameSite(), http::CookieSameSite::Strict);
+    EXPECT_TRUE(ownedCookie.isHttpOnly());
+    EXPECT_TRUE(ownedCookie.isPartitioned());
+}
+
+TEST(CookieView, FromHeaderString)
+{
+    {
+        const auto header = http::headerFromString("Set-Cookie: foo=bar; Max-Age=10; Secure; Path=/; Path=/test");
+        ASSERT_TRUE(header);
+        const auto cookie = http::cookieFromHeader(*header);
+        ASSERT_TRUE(cookie);
+        EXPECT_EQ(cookie->maxAge(), std::chrono::seconds{10});
+        EXPECT_EQ(cookie->path(), "/test");
+        EXPECT_EQ(cookie->domain(), std::nullopt);
+        EXPECT_TRUE(cookie->isSecure());
+        EXPECT_FALSE(cookie->isRemoved());
+        EXPECT_EQ(http::Cookie{*cookie}.toString(), "Set-Cookie: foo=bar; Max-Age=10; Secure; Path=/test");
+        const auto cookieHeader = cookie->asHeader();
+        ASSERT_EQ(cookieHeader.params().size(), 4);
+        EXPECT_EQ(cookieHeader.params().at(3).name(), "Path");
+        EXPECT_EQ(cookieHeader.params().at(3).value(), "/test");
+    }
+    {
+        const auto header = http::headerFromString("Set-Cookie: Path=bar; Max-Age=1O");
+        ASSERT_TRUE(header);
+        const auto cookie = http::cookieFromHeader(*header);
+        ASSERT_TRUE(cookie);
+        EXPECT_EQ(cookie->name(), "Path");
+        EXPECT_EQ(cookie->path(), std::nullopt);
+        EXPECT_EQ(cookie->maxAge(), std::nullopt);
+        EXPECT_FALSE(cookie->isSecure());
+    }
+}
+
 TEST(CookieView, CookieFormCookieView)
 {
     auto header = http::HeaderView{
@@ -176,3 +340,43 @@ TEST(CookieView, CookieFormCookieView)
     EXPECT_EQ(cookie.domain(), "localhost");
     EXPECT_EQ(cookie.isSecure(), true);
 }
+
+TEST(CookieView, FromStringWithLimits)
+{
+    {
+        auto cookies = http::cookiesFromString("name=foo; age=77", http::ParseLimits{2});
+        ASSERT_TRUE(cookies);
+        auto expectedCookies = std::vector<http::CookieView>{{"name", "foo"}, {"age", "77"}};
+        EXPECT_EQ(*cookies, expectedCookies);
+    }
+    {
+        auto cookies = http::cookiesFromString("name=foo; ;;age=77", http::ParseLimits{2});
+        EXPECT_FALSE(cookies);
+    }
+}
+
+TEST(CookieView, UnknownAttributes)
+{
+    const auto header = http::headerFromString("Set-Cookie: foo=bar; Priority=High; Path=/; Max-Age=10; Experimental");
+    ASSERT_TRUE(header);
+    const auto cookie = http::cookieFromHeader(*header);
+    ASSERT_TRUE(cookie);
+    EXPECT_EQ(cookie->path(), "/");
+    EXPECT_EQ(cookie->maxAge(), std::chrono::seconds{10});
+
+    const auto cookieHeader = cookie->asHeader();
+    ASSERT_EQ(cookieHeader.params().size(), 5);
+    EXPECT_EQ(cookieHeader.params().at(3).name(), "Priority");
+    EXPECT_EQ(cookieHeader.params().at(3).value(), "High");
+    EXPECT_EQ(cookieHeader.params().at(4).name(), "Experimental");
+    EXPECT_FALSE(cookieHeader.params().at(4).hasValue());
+
+    auto ownedCookie = http::Cookie{*cookie};
+    EXPECT_EQ(ownedCookie.toString(), "Set-Cookie: foo=bar; Path=/; Max-Age=10; Priority=High; Experimental");
+    ownedCookie.setPath("/foo");
+    EXPECT_EQ(ownedCookie.toString(), "Set-Cookie: foo=bar; Path=/foo; Max-Age=10; Priority=High; Experimental");
+    const auto cookieTemplate = http::CookieTemplate{ownedCookie};
+    EXPECT_EQ(
+            cookieTemplate.makeCookie("baz", "qux").toString(),
+            "Set-Cookie: baz=qux; Path=/foo; Max-Age=10; Priority=High; Experimental");
+}
@@ -1,6 +1,9 @@
 #include <hot_teacup/form.h>
 #include <hot_teacup/form_view.h>
 #include <gtest/gtest.h>
+#include <optional>
+#include <string>
+#include <string_view>
 
 TEST(FormView, WithoutFileFromString)
 {
@@ -303,3 +306,169 @@ TEST(FormView, UrlEncodedWithoutNameFromString)
         EXPECT_EQ(form.at("param2").value(), "bar");
     }
 }
+
+TEST(FormView, UrlEncodedFieldBoundariesFromString)
+{
+    const auto formContentType = "application/x-www-form-urlencoded";
+    const auto formData = "&&param1=foo=bar& param2 = baz &param1=ignored&&param3=";
+
+    const auto form = http::formFromString(formContentType, formData);
+    ASSERT_EQ(form.size(), 3);
+    EXPECT_EQ(form.at("param1").value(), "foo=bar");
+    EXPECT_EQ(form.at("param2").value(), " baz ");
+    EXPECT_EQ(form.at("param3").value(), "");
+}
+
+TEST(FormView, UrlEncodedManyFieldsFromString)
+{
+    const auto formContentType = "application/x-www-form-urlencoded";
+    auto formData = std::string{};
+    for (auto i = 0; i < 2000; ++i)
+        formData += "field" + std::to_string(i) + "=value" + std::to_string(i) + "&";
+
+    const auto form = http::formFromString(formContentType, formData);
+    ASSERT_EQ(form.size(), 2000);
+    EXPECT_EQ(form.at("field0").value(), "value0");
+    EXPECT_EQ(form.at("field1999").value(), "value1999");
+}
+
+TEST(FormView, FromStringWithLimits)
+{
+    const auto formContentType = "multipart/form-data; boundary=----WebKitFormBoundaryHQl9TEASIs9QyFWx";
+    const auto formData = "------WebKitFormBoundaryHQl9TEASIs9QyFWx\r\n"
+                          "Content-Disposition: form-data; name=\"param1\"\r\n\r\nfoo\r\n"
+                          "------WebKitFormBoundaryHQl9TEASIs9QyFWx\r\n"
+                          "Content-Disposition: form-data; name=\"param2\"\r\n\r\nbar \r\n"
+                          "------WebKitFormBoundaryHQl9TEASIs9QyFWx--\r\n";
+
+    auto limits = http::ParseLimits{};
+    limits.maxPartCount = 2;
+    auto form = http::formFromString(formContentType, formData, limits);
+    ASSERT_TRUE(form);
+    EXPECT_EQ(form->size(), 2);
+
+    limits.maxPartCount = 1;
+    EXPECT_FALSE(http::formFromString(formContentType, formData, limits));
+
+    limits = http::ParseLimits{};
+    limits.maxHeaderLineLength = 32;
+    EXPECT_FALSE(http::formFromString(formContentType, formData, limits));
+
+    const auto urlEncodedContentType = "application/x-www-form-urlencoded";
+    EXPECT_TRUE(http::formFromString(urlEncodedContentType, "param1=foo&param2=bar", http::ParseLimits{2}));
+    EXPECT_FALSE(http::formFromString(urlEncodedContentType, "param1=foo&&param2=bar", http::ParseLimits{2}));
+}
+
+TEST(FormView, ParseErrors)
+{
+    const auto formContentType = "multipart/form-data; boundary=----WebKitFormBoundaryHQl9TEASIs9QyFWx";
+    const auto parseError = [&](std::string_view formData) -> std::optional<http::ParseError>
+    {
+        const auto form = http::formFromString(formContentType, formData, http::ParseLimits{});
+        if (form)
+            return std::nullopt;
+        return form.error();
+    };
+
+    EXPECT_EQ(parseError(""), std::nullopt);
+    EXPECT_EQ(
+            parseError("------WebKitFormBoundaryHQl9TEASIs9QyFWx\r\n"
+                       "Content-Disposition: form-data; name=\"param1\"\r\n\r\nfoo\r\n"
+                       "------WebKitFormBoundaryHQl9TEASIs9QyFWx--\r\n"),
+            std::nullopt);
+    EXPECT_EQ(
+            parseError("------WebKitFormBoundaryHello\r\n"
+                       "Content-Disposition: form-data; name=\"param1\"\r\n\r\nfoo\r\n"
+                       "------WebKitFormBoundaryHQl9TEASIs9QyFWx--\r\n"),
+            (http::ParseError{http::ParseErrorCode::InvalidMultipartForm, 0}));
+    EXPECT_EQ(
+            parseError("------WebKitFormBoundaryHQl9TEASIs9QyFWx"
+                       "Content-Disposition: form-data; name=\"param1\"\r\n\r\nfoo\r\n"
+                       "------WebKitFormBoundaryHQl9TEASIs9QyFWx--\r\n"),
+            (http::ParseError{http::ParseErrorCode::InvalidMultipartForm, 40}));
+
+    EXPECT_EQ(
+            parseError("------WebKitFormBoundaryHQl9TEASIs9QyFWx\r\n"
+                       "Content-Disposition: form-data; name=\"param1\"\r\n\r\nfoo\r\n"
+                       "------WebKitFormBoundaryHQl9TEASIs9QyFWx-- \t\r\n"),
+            std::nullopt);
+    EXPECT_EQ(
+            parseError("------WebKitFormBoundaryHQl9TEASIs9QyFWx\r\n"
+                       "Content-Disposition: form-data; name=\"param1\"\r\n\r\nfoo\r\n"
+                       "------WebKitFormBoundaryHQl9TEASIs9QyFWx--junk\r\n"),
+            (http::ParseError{http::ParseErrorCode::InvalidMultipartForm, 136}));
+
+    const auto truncatedForm = std::string_view{"------WebKitFormBoundaryHQl9TEASIs9QyFWx\r\n"
+                                                "Content-Disposition: form-data; name=\"param1\"\r\n\r\nfoo\r\n"
+                                                "------WebKitFormBoundaryHQl9TEASIs9QyFWx\r\n"
+                                                "Content-Disposition: form-data; name=\"param2\"\r\n\r\nbar"};
+    EXPECT_EQ(
+            parseError(truncatedForm),
+            (http::ParseError{http::ParseErrorCode::TruncatedMultipartForm, truncatedForm.size()}));
+    const auto lenientForm = http::formFromString(formContentType, truncatedForm);
+    EXPECT_EQ(lenientForm.size(), 2);
+
+    const auto formWithoutBoundary = http::formFromString("multipart/form-data", "", http::ParseLimits{});
+    ASSERT_FALSE(formWithoutBoundary);
+    EXPECT_EQ(formWithoutBoundary.error().code, http::ParseErrorCode::MissingFormBoundary);
+
+    const auto notForm = http::formFromString("application/json", "{}", http::ParseLimits{});
+    ASSERT_TRUE(notForm);
+    EXPECT_TRUE(notForm->empty());
+}
+
+TEST(FormView, PartHeaderNamesAreCaseInsensitive)
+{
+    const auto formContentType = "multipart/form-data; boundary=----WebKitFormBoundaryHQl9TEASIs9QyFWx";
+    const auto formData = "------WebKitFormBoundaryHQl9TEASIs9QyFWx\r\n"
+                          "content-disposition: form-data; name=\"param1\"; filename=\"test.txt\"\r\n"
+                          "CONTENT-TYPE: text/plain\r\n\r\nfoo\r\n"
+                          "------WebKitFormBoundaryHQl9TEASIs9QyFWx--\r\n";
+
+    const auto form = http::formFromString(formContentType, formData);
+
+    ASSERT_EQ(form.count("param1"), 1);
+    EXPECT_EQ(form.at("param1").type(), http::FormFieldType::File);
+    EXPECT_EQ(form.at("param1").fileName(), "test.txt");
+    EXPECT_EQ(form.at("param1").fileType(), "text/plain");
+    EXPECT_EQ(form.at("param1").value(), "foo");
+}
+
+TEST(FormView, ContentTypeIsCaseInsensitive)
+{
+    const auto form = http::formFromString("Application/X-WWW-Form-Urlencoded", "param1=foo");
+    ASSERT_EQ(form.size(), 1);
+    EXPECT_EQ(form.at("param1").value(), "foo");
+}
+
+TEST(FormView, PartHeadersOtherThanContentAreSkipped)
+{
+    const auto formContentType = "multipart/form-data; boundary=----WebKitFormBoundaryHQl9TEASIs9QyFWx";
+    const auto formData = "------WebKitFormBoundaryHQl9TEASIs9QyFWx\r\n"
+                          "X-Part-Id: 1; name=ignored\r\n"
+                          "Invalid header line\r\n"
+                          "Content-Disposition: form-data; NAME=\"param1\"; name=\"param2\"; FileName=test.txt\r\n"
+                          "Content-Type: text/plain; charset=utf-8\r\n"
+                          "Content-Transfer-Encoding: binary\r\n\r\nfoo\r\n"
+                          "------WebKitFormBoundaryHQl9TEASIs9QyFWx\r\n"
+                          "Content-Disposition: form-data; name=\"param3\"; filename\r\n\r\nbar\r\n"
+                          "------WebKitFormBoundaryHQl9TEASIs9QyFWx\r\n"
+                          "Content-Disposition: name=param4\r\n\r\nbaz\r\n"
+                          "------WebKitFormBoundaryHQl9TEASIs9QyFWx--\r\n";
+
+    const auto form = http::formFromString(formContentType, formData);
+
+    ASSERT_EQ(form.size(), 3);
+    ASSERT_EQ(form.count("param1"), 1);
+    EXPECT_EQ(form.at("param1").type(), http::FormFieldType::File);
+    EXPECT_EQ(form.at("param1").fileName(), "test.txt");
+    EXPECT_EQ(form.at("param1").fileType(), "text/plain");
+    EXPECT_EQ(form.at("param1").value(), "foo");
+    ASSERT_EQ(form.count("param3"), 1);
+    EXPECT_EQ(form.at("param3").type(), http::FormFieldType::File);
+    EXPECT_FALSE(form.at("param3").hasFile());
+    EXPECT_EQ(form.at("param3").value(), "bar");
+    ASSERT_EQ(form.count("param4"), 1);
+    EXPECT_EQ(form.at("param4").type(), http::FormFieldType::Param);
+    EXPECT_EQ(form.at("param4").value(), "baz");
+}
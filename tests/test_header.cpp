@@ -1,6 +1,8 @@
 #include <hot_teacup/header.h>
 #include <hot_teacup/header_view.h>
 #include <gtest/gtest.h>
+#include <type_traits>
+#include <vector>
 
 TEST(Header, ToString)
 {
@@ -115,6 +117,80 @@ TEST(HeaderView, HeaderFromHeaderView)
     EXPECT_EQ(header.param("name2"), "bar");
 }
 
+TEST(HeaderView, StdVectorParams)
+{
+    const auto params = std::vector<http::HeaderParamView>{{"name", "foo"}, http::HeaderParamView{"flag"}};
+    const auto headerView = http::HeaderView{"Test-Header", "test", http::HeaderParamViewList{params}};
+    ASSERT_EQ(headerView.params().size(), 2);
+    EXPECT_EQ(headerView.param("name"), "foo");
+    const auto viewParams = std::vector<http::HeaderParamView>(headerView.params());
+    EXPECT_EQ(viewParams.size(), 2);
+    static_assert(!std::is_convertible_v<std::vector<http::HeaderParamView>, http::HeaderParamViewList>);
+    static_assert(!std::is_convertible_v<http::HeaderParamViewList, std::vector<http::HeaderParamView>>);
+
+    const auto headerParams = http::makeHeaderParams(params);
+    ASSERT_EQ(headerParams.size(), 2);
+    EXPECT_EQ(headerParams.at(0).toString(http::HeaderQuotingMode::None), "name=foo");
+    EXPECT_EQ(headerParams.at(1).toString(http::HeaderQuotingMode::None), "flag");
+    EXPECT_EQ(http::Header{headerView}.toString(), "Test-Header: test; name=foo; flag");
+}
+
+TEST(HeaderView, FromStringWithManyParams)
+{
+    const auto header = http::headerFromString("Test-Header: test; a=1;; b=2; c; d=4; e=5 ; f=\"6\"");
+    ASSERT_TRUE(header.has_value());
+    EXPECT_EQ(header->value(), "test");
+    ASSERT_EQ(header->params().size(), 6);
+    EXPECT_EQ(header->params().at(2).name(), "c");
+    EXPECT_FALSE(header->params().at(2).hasValue());
+    EXPECT_EQ(header->param("e"), "5 ");
+    EXPECT_EQ(header->param("f"), "6");
+
+    const auto ownedHeader = http::Header{*header};
+    EXPECT_EQ(ownedHeader.toString(), "Test-Header: test; a=1; b=2; c; d=4; e=5 ; f=6");
+    EXPECT_FALSE(http::headerFromString("Test-Header; a=1"));
+    EXPECT_FALSE(http::headerFromString(" : test"));
+    EXPECT_FALSE(http::headerFromString(";;"));
+}
+
+TEST(HeaderView, FromStringWithFlagParams)
+{
+    {
+        const auto header = http::headerFromString("Content-Type: text/html; charset=utf-8; secure");
+        ASSERT_TRUE(header.has_value());
+        EXPECT_EQ(header->value(), "text/html");
+        ASSERT_EQ(header->params().size(), 2);
+        EXPECT_EQ(header->param("charset"), "utf-8");
+        EXPECT_TRUE(header->params().at(0).hasValue());
+        ASSERT_TRUE(header->hasParam("secure"));
+        EXPECT_EQ(header->param("secure"), "");
+        EXPECT_FALSE(header->params().at(1).hasValue());
+        EXPECT_EQ(http::Header{*header}.toString(), "Content-Type: text/html; charset=utf-8; secure");
+    }
+    {
+        const auto header =
+                http::headerFromString("Content-Disposition: form-data; name=\"foo\"; inline ; filename=\"\"");
+        ASSERT_TRUE(header.has_value());
+        EXPECT_EQ(header->value(), "form-data");
+        ASSERT_EQ(header->params().size(), 3);
+        EXPECT_EQ(header->param("name"), "foo");
+        EXPECT_EQ(header->params().at(1).name(), "inline");
+        EXPECT_FALSE(header->params().at(1).hasValue());
+        EXPECT_EQ(header->param("filename"), "");
+        EXPECT_TRUE(header->params().at(2).hasValue());
+    }
+    {
+        const auto header = http::headerFromString("Set-Cookie: id=hello; Secure; HttpOnly");
+        ASSERT_TRUE(header.has_value());
+        EXPECT_EQ(header->value(), "");
+        ASSERT_EQ(header->params().size(), 3);
+        EXPECT_EQ(header->params().at(0).name(), "id");
+        EXPECT_FALSE(header->params().at(1).hasValue());
+        EXPECT_FALSE(header->params().at(2).hasValue());
+        EXPECT_TRUE(header->hasParam("httponly"));
+    }
+}
+
 TEST(HeaderView, FromStringWithoutHeaderValue)
 {
     {
@@ -195,3 +271,44 @@ TEST(HeaderView, FromStringWithoutHeaderName)
         ASSERT_FALSE(header.has_value());
     }
 }
+
+TEST(HeaderView, FromStringWithLimits)
+{
+    auto limits = http::ParseLimits{};
+    limits.maxHeaderLineLength = 16;
+    EXPECT_TRUE(http::headerFromString("Location: /", limits));
+    EXPECT_FALSE(http::headerFromString("Location: /very/long/path", limits));
+
+    limits = http::ParseLimits{2};
+    EXPECT_TRUE(http::headerFromString("Content-Disposition: form-data; name=\"foo\"", limits));
+    EXPECT_FALSE(http::headerFromString("Content-Disposition: form-data; name=\"foo\"; filename=\"bar\"", limits));
+}
+
+TEST(Header, KnownHeaderFromString)
+{
+    EXPECT_EQ(http::knownHeaderFromString("Content-Type"), http::KnownHeader::ContentType);
+    EXPECT_EQ(http::knownHeaderFromString("content-type"), http::KnownHeader::ContentType);
+    EXPECT_EQ(http::knownHeaderFromString("SET-COOKIE"), http::KnownHeader::SetCookie);
+    EXPECT_EQ(http::knownHeaderFromString("Last-Modified"), http::KnownHeader::LastModified);
+    EXPECT_EQ(http::knownHeaderFromString("Cache-Control"), http::KnownHeader::CacheControl);
+    EXPECT_EQ(http::knownHeaderFromString("Content-Typo"), std::nullopt);
+    EXPECT_EQ(http::knownHeaderFromString("X-Test"), std::nullopt);
+    EXPECT_EQ(http::knownHeaderFromString(""), std::nullopt);
+    static_assert(http::knownHeaderFromString("content-disposition") == http::KnownHeader::ContentDisposition);
+}
+
+TEST(HeaderView, ParamNamesAreCaseInsensitive)
+{
+    const auto header = http::headerFromString("Content-Disposition: form-data; NAME=\"foo\"; FileName=\"bar.txt\"");
+    ASSERT_TRUE(header);
+    EXPECT_TRUE(header->hasParam("name"));
+    EXPECT_EQ(header->param("name"), "foo");
+    EXPECT_EQ(header->param("filename"), "bar.txt");
+    EXPECT_FALSE(header->hasParam("names"));
+    EXPECT_THROW(header->param("nam"), std::out_of_range);
+
+    auto ownedHeader = http::Header{*header};
+    EXPECT_EQ(ownedHeader.param("Name"), "foo");
+    ownedHeader.setParam("name", "baz");
+    EXPECT_EQ(ownedHeader.toString(), "Content-Disposition: form-data; name=baz; FileName=bar.txt");
+}
@@ -0,0 +1,73 @@
+#include <hot_teacup/cookie.h>
+#include <hot_teacup/http_date.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+
+namespace {
+std::chrono::system_clock::time_point timeFromSeconds(std::int64_t seconds)
+{
+    return std::chrono::system_clock::time_point{std::chrono::seconds{seconds}};
+}
+
+bool isSystemClockTime(std::int64_t seconds)
+{
+    return seconds >= std::chrono::ceil<std::chrono::seconds>(std::chrono::system_clock::duration::min()).count() &&
+            seconds <= std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::duration::max()).count();
+}
+} //namespace
+
+TEST(HttpDate, ToString)
+{
+    EXPECT_EQ(http::httpDateToString(timeFromSeconds(0)), "Thu, 01 Jan 1970 00:00:00 GMT");
+    EXPECT_EQ(http::httpDateToString(timeFromSeconds(784111777)), "Sun, 06 Nov 1994 08:49:37 GMT");
+    EXPECT_EQ(http::httpDateToString(timeFromSeconds(951782400)), "Tue, 29 Feb 2000 00:00:00 GMT");
+    EXPECT_EQ(http::httpDateToString(timeFromSeconds(-1)), "Wed, 31 Dec 1969 23:59:59 GMT");
+    EXPECT_EQ(
+            http::httpDateToString(timeFromSeconds(784111777) + std::chrono::milliseconds{999}),
+            "Sun, 06 Nov 1994 08:49:37 GMT");
+
+    //years outside of 0-9999 are reachable only with a system_clock wider than the libstdc++ one
+    if (isSystemClockTime(253402300800) && isSystemClockTime(-62167219201)) {
+        EXPECT_EQ(http::httpDateToString(timeFromSeconds(253402300799)), "Fri, 31 Dec 9999 23:59:59 GMT");
+        EXPECT_EQ(http::httpDateToString(timeFromSeconds(253402300800)), "Fri, 31 Dec 9999 23:59:59 GMT");
+        EXPECT_EQ(http::httpDateToString(timeFromSeconds(-62167219200)), "Sat, 01 Jan 0000 00:00:00 GMT");
+        EXPECT_EQ(http::httpDateToString(timeFromSeconds(-62167219201)), "Sat, 01 Jan 0000 00:00:00 GMT");
+    }
+}
+
+TEST(HttpDate, FromString)
+{
+    EXPECT_EQ(http::httpDateFromString("Sun, 06 Nov 1994 08:49:37 GMT"), timeFromSeconds(784111777));
+    EXPECT_EQ(http::httpDateFromString("Tue, 29 Feb 2000 00:00:00 GMT"), timeFromSeconds(951782400));
+    EXPECT_EQ(http::httpDateFromString("Wed, 31 Dec 1969 23:59:59 GMT"), timeFromSeconds(-1));
+    EXPECT_EQ(http::httpDateFromString("Sun, 06 Nov 1994 08:49:37 UTC"), std::nullopt);
+    EXPECT_EQ(http::httpDateFromString("Sunday, 06-Nov-94 08:49:37 GMT"), std::nullopt);
+    EXPECT_EQ(http::httpDateFromString("Sun, 06 Foo 1994 08:49:37 GMT"), std::nullopt);
+    EXPECT_EQ(http::httpDateFromString("Mon, 29 Feb 2001 00:00:00 GMT"), std::nullopt);
+    EXPECT_EQ(http::httpDateFromString("Sun, 06 Nov 1994 24:49:37 GMT"), std::nullopt);
+    EXPECT_EQ(http::httpDateFromString("Sun, 06 Nov 19x4 08:49:37 GMT"), std::nullopt);
+    EXPECT_EQ(http::httpDateFromString("Mon, 06 Nov 1994 08:49:37 GMT"), std::nullopt);
+    if (isSystemClockTime(253402300799))
+        EXPECT_EQ(http::httpDateFromString("Fri, 31 Dec 9999 23:59:59 GMT"), timeFromSeconds(253402300799));
+    else
+        EXPECT_EQ(http::httpDateFromString("Fri, 31 Dec 9999 23:59:59 GMT"), std::nullopt);
+}
+
+TEST(HttpDate, CurrentDate)
+{
+    const auto before = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+    const auto date = http::currentHttpDate();
+    const auto after = std::chrono::system_clock::now();
+    const auto time = http::httpDateFromString(date);
+    ASSERT_TRUE(time);
+    EXPECT_GE(*time, before);
+    EXPECT_LE(*time, after);
+    EXPECT_GE(http::httpDateFromString(http::currentHttpDate()).value(), *time);
+}
+
+TEST(HttpDate, CookieExpires)
+{
+    auto cookie = http::Cookie{"foo", "bar"};
+    cookie.setExpires(timeFromSeconds(784111777));
+    EXPECT_EQ(cookie.toString(), "Set-Cookie: foo=bar; Expires=Sun, 06 Nov 1994 08:49:37 GMT");
+}
@@ -0,0 +1,88 @@
+#include <hot_teacup/form_view.h>
+#include <hot_teacup/metrics.h>
+#include <hot_teacup/request_view.h>
+#include <hot_teacup/response.h>
+#include <hot_teacup/response_view.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+TEST(Metrics, RequestViewParsing)
+{
+    http::resetThreadMetrics();
+    const auto request = http::RequestView{"GET", {}, {}, {}, "param1=foo&param2=bar", "id=100", {}, {}};
+    const auto& metrics = http::threadMetrics().requestViewParsing;
+    if constexpr (http::metricsEnabled()) {
+        EXPECT_EQ(metrics.callCount, 1);
+        EXPECT_EQ(metrics.elementCount, 3);
+        EXPECT_EQ(metrics.processedBytes, 27);
+        EXPECT_GT(metrics.allocationCount, 0);
+        EXPECT_GT(metrics.allocatedBytes, 0);
+    }
+    else
+        EXPECT_EQ(metrics.callCount, 0);
+}
+
+TEST(Metrics, FormParsing)
+{
+    http::resetThreadMetrics();
+    const auto form = http::formFromString("application/x-www-form-urlencoded", "id=100&name=foo");
+    const auto& metrics = http::threadMetrics().formParsing;
+    if constexpr (http::metricsEnabled()) {
+        EXPECT_EQ(metrics.callCount, 1);
+        EXPECT_EQ(metrics.elementCount, 2);
+        EXPECT_EQ(metrics.processedBytes, 15);
+    }
+    else
+        EXPECT_EQ(metrics.callCount, 0);
+}
+
+TEST(Metrics, ResponseParsingAndSerialization)
+{
+    http::resetThreadMetrics();
+    const auto responseView =
+            http::responseFromString("HTTP/1.1 200 OK\r\nSet-Cookie: id=hello\r\nLocation: /\r\n\r\n");
+    ASSERT_TRUE(responseView);
+    const auto data = http::Response{*responseView}.data();
+    const auto& parsingMetrics = http::threadMetrics().responseParsing;
+    const auto& serializationMetrics = http::threadMetrics().responseSerialization;
+    if constexpr (http::metricsEnabled()) {
+        EXPECT_EQ(parsingMetrics.callCount, 1);
+        EXPECT_EQ(parsingMetrics.elementCount, 2);
+        EXPECT_EQ(serializationMetrics.callCount, 1);
+        EXPECT_EQ(serializationMetrics.elementCount, 2);
+        EXPECT_EQ(serializationMetrics.processedBytes, data.size());
+    }
+    else {
+        EXPECT_EQ(parsingMetrics.callCount, 0);
+        EXPECT_EQ(serializationMetrics.callCount, 0);
+    }
+}
+
+TEST(Metrics, Callback)
+{
+    auto operations = std::vector<http::MetricsOperation>{};
+    http::setMetricsCallback(
+            [&](http::MetricsOperation operation, const http::OperationMetrics&)
+            {
+                operations.push_back(operation);
+            });
+    const auto form = http::formFromString("application/x-www-form-urlencoded", "id=100");
+    http::setMetricsCallback({});
+    if constexpr (http::metricsEnabled())
+        EXPECT_EQ(operations, std::vector<http::MetricsOperation>{http::MetricsOperation::FormParsing});
+    else
+        EXPECT_TRUE(operations.empty());
+}
+
+TEST(Metrics, ThrowingCallback)
+{
+    http::setMetricsCallback(
+            [](http::MetricsOperation, const http::OperationMetrics&)
+            {
+                throw std::runtime_error{"callback error"};
+            });
+    const auto request = http::RequestView{"GET", {}, {}, {}, "id=100", {}, {}, {}};
+    http::setMetricsCallback({});
+    EXPECT_EQ(request.query("id"), "100");
+}
@@ -64,6 +64,12 @@ TEST(QueryView, FromString)
         auto expectedQueries = std::vector<http::QueryView>{};
         EXPECT_EQ(queries, expectedQueries);
     }
+    {
+        auto queries = http::queriesFromString(" flag & name = a=b &empty=&");
+        auto expectedQueries = std::vector<http::QueryView>{{"flag", ""}, {"name", "a=b"}, {"empty", ""}};
+        EXPECT_EQ(queries, expectedQueries);
+        EXPECT_EQ(queries.capacity(), 4);
+    }
 }
 
 TEST(QueryView, QueryFromQueryView)
@@ -72,3 +78,23 @@ TEST(QueryView, QueryFromQueryView)
     auto expectedQueries = std::vector<http::Query>{{"name", "test"}, {"foo", "bar"}};
     EXPECT_EQ(http::makeQueries(queries), expectedQueries);
 }
+
+TEST(QueryView, FromStringWithLimits)
+{
+    {
+        auto queries = http::queriesFromString("name=test&foo=bar", http::ParseLimits{2});
+        ASSERT_TRUE(queries);
+        auto expectedQueries = std::vector<http::QueryView>{{"name", "test"}, {"foo", "bar"}};
+        EXPECT_EQ(*queries, expectedQueries);
+    }
+    {
+        auto queries = http::queriesFromString("name=test&&&foo=bar", http::ParseLimits{2});
+        EXPECT_FALSE(queries);
+    }
+    {
+        auto limits = http::ParseLimits{};
+        limits.maxTotalSize = 8;
+        auto queries = http::queriesFromString("name=test&foo=bar", limits);
+        EXPECT_FALSE(queries);
+    }
+}
@@ -2,7 +2,10 @@
 #include <hot_teacup/request_view.h>
 #include <hot_teacup/types.h>
 #include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
 #include <functional>
+#include <iterator>
 
 TEST(RequestView, RequestMethodParam)
 {
@@ -21,6 +24,11 @@ TEST(RequestView, RequestMethodParam)
     testRequestType("DELETE", http::RequestMethod::Delete);
     testRequestType("CONNECT", http::RequestMethod::Connect);
     testRequestType("OPTIONS", http::RequestMethod::Options);
+    testRequestType("GETS", http::RequestMethod::Get);
+    testRequestType("PUSH", http::RequestMethod::Get);
+    testRequestType("options", http::RequestMethod::Get);
+    testRequestType("", http::RequestMethod::Get);
+    static_assert(http::methodFromString("PATCH") == http::RequestMethod::Patch);
 }
 
 TEST(RequestView, RequestFromRequestViewWithMethodParam)
@@ -377,3 +385,161 @@ TEST(Request, ToFcgiDataWithMultipartForm)
     ASSERT_TRUE(fcgiData.params.count("CONTENT_TYPE"));
     EXPECT_EQ(fcgiData.params.at("CONTENT_TYPE"), "multipart/form-data; boundary=----asyncgiFormBoundary");
 }
+
+TEST(Request, SetAndTakeFormWithoutCopy)
+{
+    auto fileData = std::string(1024, 'x');
+    const auto fileDataBuffer = fileData.data();
+    auto form = http::Form{};
+    form.emplace("file", http::FormField{std::move(fileData), "test.txt"});
+    auto request = http::Request{http::RequestMethod::Post, "/"};
+    request.setForm(std::move(form));
+    EXPECT_EQ(request.fileData("file").data(), fileDataBuffer);
+
+    auto takenForm = request.takeForm();
+    EXPECT_EQ(takenForm.at("file").value().data(), fileDataBuffer);
+    EXPECT_FALSE(request.hasFiles());
+}
+
+TEST(RequestView, SharedRequestViewOutlivesInput)
+{
+    auto makeRequest = []
+    {
+        auto queryString = std::string{"param1=foo&param2=bar"};
+        auto cookieString = std::string{"id=100"};
+        auto formString = std::string{"name=baz"};
+        return http::SharedRequestView{
+                "POST",
+                {},
+                "localhost",
+                "/test?param1=foo",
+                queryString,
+                cookieString,
+                "application/x-www-form-urlencoded",
+                formString};
+    };
+    const auto request = makeRequest();
+    const auto requestCopy = request;
+    for (const auto* requestView : {&request, &requestCopy}) {
+        EXPECT_EQ(requestView->method(), http::RequestMethod::Post);
+        EXPECT_EQ(requestView->domainName(), "localhost");
+        EXPECT_EQ(requestView->path(), "/test");
+        EXPECT_EQ(requestView->query("param1"), "foo");
+        EXPECT_EQ(requestView->query("param2"), "bar");
+        EXPECT_EQ(requestView->cookie("id"), "100");
+        EXPECT_EQ(requestView->formField("name"), "baz");
+    }
+    EXPECT_EQ(request.path().data(), requestCopy.path().data());
+}
+
+TEST(RequestView, RequestFromRequestViewWithSpooledFile)
+{
+    auto formData = std::string{"------WebKitFormBoundaryHQl9TEASIs9QyFWx\r\n"
+                                "Content-Disposition: form-data; name=\"param1\"\r\n\r\nfoo\r\n"
+                                "------WebKitFormBoundaryHQl9TEASIs9QyFWx\r\n"
+                                "Content-Disposition: form-data; name=\"param2\"; filename=\"small.txt\"\r\n"
+                                "Content-Type: text/plain\r\n\r\nsmall\r\n"
+                                "------WebKitFormBoundaryHQl9TEASIs9QyFWx\r\n"
+                                "Content-Disposition: form-data; name=\"param3\"; filename=\"test.gif\"\r\n"
+                                "Content-Type: image/gif\r\n\r\ntest-gif-data\r\n"
+                                "------WebKitFormBoundaryHQl9TEASIs9QyFWx--\r\n"};
+
+    const auto requestView = http::RequestView{
+            "POST",
+            {},
+            {},
+            {},
+            {},
+            {},
+            "multipart/form-data; boundary=----WebKitFormBoundaryHQl9TEASIs9QyFWx",
+            formData};
+    auto filePath = std::filesystem::path{};
+    {
+        const auto request = http::Request{requestView, http::FormFileSpooling{8}};
+        EXPECT_EQ(request.formField("param1"), "foo");
+
+        EXPECT_EQ(request.fileData("param2"), "small");
+        EXPECT_TRUE(request.filePath("param2").empty());
+
+        EXPECT_TRUE(request.hasFile("param3"));
+        EXPECT_EQ(request.fileData("param3"), "");
+        EXPECT_EQ(request.fileName("param3"), "test.gif");
+        EXPECT_EQ(request.fileType("param3"), "image/gif");
+        filePath = request.filePath("param3");
+        ASSERT_TRUE(std::filesystem::exists(filePath));
+#ifndef _WIN32
+        const auto permissions = std::filesystem::status(filePath).permissions();
+        EXPECT_EQ(
+                permissions & (std::filesystem::perms::group_all | std::filesystem::perms::others_all),
+                std::filesystem::perms::none);
+#endif
+        auto file = std::ifstream{filePath, std::ios::binary};
+        EXPECT_EQ(std::string(std::istreambuf_iterator<char>{file}, {}), "test-gif-data");
+
+        const auto fcgiData = request.toFcgiData(http::FormType::Multipart);
+        EXPECT_NE(fcgiData.stdIn.find("test-gif-data"), std::string::npos);
+    }
+    EXPECT_FALSE(std::filesystem::exists(filePath));
+}
+
+TEST(RequestView, ParseError)
+{
+    {
+        const auto request =
+                http::RequestView{"GET", {}, {}, {}, "param1=foo&param2=bar", "id=100", {}, {}, http::ParseLimits{2}};
+        EXPECT_FALSE(request.parseError());
+        EXPECT_EQ(request.query("param2"), "bar");
+        EXPECT_EQ(request.cookie("id"), "100");
+    }
+    {
+        const auto request = http::RequestView{
+                "GET",
+                {},
+                {},
+                {},
+                "param1=foo&param2=bar&param3=baz",
+                "id=100",
+                {},
+                {},
+                http::ParseLimits{2}};
+        ASSERT_TRUE(request.parseError());
+        EXPECT_EQ(
+                *request.parseError(),
+                (http::ParseError{http::ParseErrorCode::LimitExceeded, 22, http::ParseErrorSource::QueryString}));
+        EXPECT_TRUE(request.queries().empty());
+        EXPECT_TRUE(request.cookies().empty());
+    }
+    {
+        const auto formData = "------WebKitFormBoundaryHQl9TEASIs9QyFWx\r\n"
+                              "Content-Disposition: form-data; name=\"param1\"\r\n\r\nfoo\r\n";
+        const auto request = http::RequestView{
+                "POST",
+                {},
+                {},
+                {},
+                "param1=foo",
+                {},
+                "multipart/form-data; boundary=----WebKitFormBoundaryHQl9TEASIs9QyFWx",
+                formData,
+                http::ParseLimits{}};
+        ASSERT_TRUE(request.parseError());
+        EXPECT_EQ(request.parseError()->code, http::ParseErrorCode::TruncatedMultipartForm);
+        EXPECT_EQ(request.parseError()->source, http::ParseErrorSource::Form);
+        EXPECT_TRUE(request.queries().empty());
+        EXPECT_TRUE(request.form().empty());
+    }
+    {
+        const auto request = http::RequestView{
+                "GET",
+                {},
+                {},
+                {},
+                "param1=foo",
+                "id=100; name=foo; x=1",
+                {},
+                {},
+                http::ParseLimits{2}};
+        ASSERT_TRUE(request.parseError());
+        EXPECT_EQ(request.parseError()->source, http::ParseErrorSource::Cookies);
+    }
+}
@@ -0,0 +1,76 @@
+#include <hot_teacup/request_batch.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+std::vector<std::string> makeQueryStrings(int count)
+{
+    auto result = std::vector<std::string>{};
+    for (auto i = 0; i < count; ++i)
+        result.push_back("id=" + std::to_string(i));
+    return result;
+}
+} //namespace
+
+TEST(RequestBatch, ParseRequests)
+{
+    const auto queryStrings = makeQueryStrings(1000);
+    auto records = std::vector<http::RequestRecord>{};
+    for (const auto& queryString : queryStrings)
+        records.push_back({"GET", {}, {}, "/test", queryString, "name=foo", {}, {}});
+
+    for (auto threadCount : {0u, 1u, 4u}) {
+        const auto requests = http::parseRequests(records, threadCount);
+        ASSERT_EQ(requests.size(), records.size());
+        for (auto i = 0u; i < requests.size(); ++i) {
+            EXPECT_EQ(requests[i].method(), http::RequestMethod::Get);
+            EXPECT_EQ(requests[i].path(), "/test");
+            EXPECT_EQ(requests[i].query("id"), std::to_string(i));
+            EXPECT_EQ(requests[i].cookie("name"), "foo");
+        }
+    }
+}
+
+TEST(RequestBatch, VisitRequests)
+{
+    const auto queryStrings = makeQueryStrings(1000);
+    auto records = std::vector<http::RequestRecord>{};
+    for (const auto& queryString : queryStrings)
+        records.push_back({"POST", {}, {}, {}, queryString, {}, {}, {}});
+
+    auto visitedCount = std::atomic<int>{};
+    auto mismatchCount = std::atomic<int>{};
+    http::visitRequests(
+            records,
+            [&](std::size_t index, const http::RequestView& request)
+            {
+                visitedCount++;
+                if (request.query("id") != std::to_string(index))
+                    mismatchCount++;
+            },
+            4);
+    EXPECT_EQ(visitedCount, 1000);
+    EXPECT_EQ(mismatchCount, 0);
+}
+
+TEST(RequestBatch, VisitorException)
+{
+    const auto queryStrings = makeQueryStrings(100);
+    auto records = std::vector<http::RequestRecord>{};
+    for (const auto& queryString : queryStrings)
+        records.push_back({"GET", {}, {}, {}, queryString, {}, {}, {}});
+
+    EXPECT_THROW(
+            http::visitRequests(
+                    records,
+                    [](std::size_t index, const http::RequestView&)
+                    {
+                        if (index == 50)
+                            throw std::runtime_error{"error"};
+                    },
+                    4),
+            std::runtime_error);
+}
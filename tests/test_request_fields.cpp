@@ -0,0 +1,149 @@
+#include <hot_teacup/request_fields.h>
+#include <hot_teacup/request_view.h>
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+enum class Order {
+    Ascending,
+    Descending
+};
+
+struct SearchParams {
+    int page = 0;
+    double ratio = 0;
+    std::optional<Order> order;
+    std::optional<bool> isExact;
+    std::string_view text;
+    std::string author;
+};
+
+constexpr auto searchSchema = http::FieldSchema{
+        http::fromQuery("page", &SearchParams::page),
+        http::fromQuery("ratio", &SearchParams::ratio),
+        http::fromQuery("order", &SearchParams::order),
+        http::fromForm("exact", &SearchParams::isExact),
+        http::fromForm("text", &SearchParams::text),
+        http::fromForm("author", &SearchParams::author)};
+} //namespace
+
+template<>
+struct http::FieldConverter<Order> {
+    static std::optional<Order> fromString(std::string_view value)
+    {
+        if (value == "asc")
+            return Order::Ascending;
+        if (value == "desc")
+            return Order::Descending;
+        return std::nullopt;
+    }
+};
+
+TEST(RequestFields, Extract)
+{
+    const auto request = http::RequestView{
+            "POST",
+            {},
+            {},
+            "/search",
+            "page=2&ratio=0.75&order=desc&page=3",
+            {},
+            "application/x-www-form-urlencoded",
+            "text=hello&author=John&exact=1"};
+    const auto result = searchSchema.extract(request);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result->page, 2);
+    EXPECT_EQ(result->ratio, 0.75);
+    EXPECT_EQ(result->order, Order::Descending);
+    EXPECT_EQ(result->isExact, true);
+    EXPECT_EQ(result->text, "hello");
+    EXPECT_EQ(result->author, "John");
+}
+
+TEST(RequestFields, OptionalFields)
+{
+    const auto request = http::RequestView{
+            "POST",
+            {},
+            {},
+            "/search",
+            "page=1&ratio=-1e2",
+            {},
+            "application/x-www-form-urlencoded",
+            "text=&author=John"};
+    const auto result = searchSchema.extract(request);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result->page, 1);
+    EXPECT_EQ(result->ratio, -100);
+    EXPECT_FALSE(result->order);
+    EXPECT_FALSE(result->isExact);
+    EXPECT_EQ(result->text, "");
+}
+
+TEST(RequestFields, Errors)
+{
+    const auto request = http::RequestView{
+            "POST",
+            {},
+            {},
+            "/search",
+            "page=2x&ratio=&order=random",
+            {},
+            "application/x-www-form-urlencoded",
+            "exact=yes&page=2"};
+    const auto result = searchSchema.extract(request);
+    ASSERT_FALSE(result);
+    const auto expectedErrors = std::vector<http::FieldError>{
+            {"page", http::FieldSource::Query, http::FieldErrorCode::InvalidValue},
+            {"ratio", http::FieldSource::Query, http::FieldErrorCode::InvalidValue},
+            {"order", http::FieldSource::Query, http::FieldErrorCode::InvalidValue},
+            {"exact", http::FieldSource::Form, http::FieldErrorCode::InvalidValue},
+            {"text", http::FieldSource::Form, http::FieldErrorCode::Missing},
+            {"author", http::FieldSource::Form, http::FieldErrorCode::Missing}};
+    EXPECT_EQ(result.error(), expectedErrors);
+}
+
+TEST(RequestFields, IntegerOverflow)
+{
+    struct Params {
+        unsigned char value = 0;
+    };
+    const auto schema = http::FieldSchema{http::fromQuery("value", &Params::value)};
+
+    const auto validRequest = http::RequestView{"GET", {}, {}, "/", "value=255", {}, {}, {}};
+    const auto validResult = schema.extract(validRequest);
+    ASSERT_TRUE(validResult);
+    EXPECT_EQ(validResult->value, 255);
+
+    const auto invalidRequest = http::RequestView{"GET", {}, {}, "/", "value=256", {}, {}, {}};
+    const auto invalidResult = schema.extract(invalidRequest);
+    ASSERT_FALSE(invalidResult);
+    EXPECT_EQ(invalidResult.error().at(0).code, http::FieldErrorCode::InvalidValue);
+}
+
+TEST(RequestFields, FloatingPointFields)
+{
+    struct Params {
+        double ratio = 0;
+        std::optional<float> scale;
+    };
+    const auto schema =
+            http::FieldSchema{http::fromQuery("ratio", &Params::ratio), http::fromQuery("scale", &Params::scale)};
+
+    const auto validRequest = http::RequestView{"GET", {}, {}, "/", "ratio=-2.5e-3&scale=0.5", {}, {}, {}};
+    const auto validResult = schema.extract(validRequest);
+    ASSERT_TRUE(validResult);
+    EXPECT_EQ(validResult->ratio, -2.5e-3);
+    EXPECT_EQ(validResult->scale, 0.5f);
+
+    for (const auto* ratio : {"+1", "0x10", "1.5.2", "1e999", "1,5"}) {
+        const auto query = std::string{"ratio="} + ratio;
+        const auto invalidRequest = http::RequestView{"GET", {}, {}, "/", query, {}, {}, {}};
+        const auto invalidResult = schema.extract(invalidRequest);
+        ASSERT_FALSE(invalidResult) << ratio;
+        EXPECT_EQ(invalidResult.error().at(0).code, http::FieldErrorCode::InvalidValue);
+    }
+}
@@ -1,7 +1,9 @@
+#include <hot_teacup/http_date.h>
 #include <hot_teacup/response.h>
 #include <hot_teacup/response_view.h>
 #include <gtest/gtest.h>
 #include <functional>
+#include <type_traits>
 
 namespace {
 
@@ -392,4 +394,214 @@ TEST(ResponseView, ResponseFromStringPartialStatus2)
     EXPECT_EQ(response->headers().at(0).name(), "Location");
     EXPECT_EQ(response->headers().at(0).value(), "/");
     EXPECT_EQ(response->body(), "");
-}
\ No newline at end of file
+}
+
+TEST(Response, SetAndTakeBodyWithoutCopy)
+{
+    auto body = std::string(1024, 'x');
+    const auto bodyBuffer = body.data();
+    auto response = http::Response{http::ResponseStatus::_200_Ok};
+    response.setBody(std::move(body));
+    EXPECT_EQ(response.body().data(), bodyBuffer);
+
+    auto takenBody = response.takeBody();
+    EXPECT_EQ(takenBody.data(), bodyBuffer);
+    EXPECT_EQ(takenBody, std::string(1024, 'x'));
+    EXPECT_TRUE(response.body().empty());
+}
+
+TEST(Response, AddCookiesAndHeadersWithoutCopy)
+{
+    auto cookies = std::vector<http::Cookie>{http::Cookie{"name", "foo"}, http::Cookie{"age", "77"}};
+    const auto cookiesBuffer = cookies.data();
+    auto headers = std::vector<http::Header>{http::Header{"Host", "HotTeacup"}, http::Header{"User-Agent", "gtest"}};
+    const auto headersBuffer = headers.data();
+
+    auto response = http::Response{http::ResponseStatus::_200_Ok};
+    response.addCookies(std::move(cookies));
+    response.addHeaders(std::move(headers));
+    EXPECT_EQ(response.cookies().data(), cookiesBuffer);
+    EXPECT_EQ(response.headers().data(), headersBuffer);
+    EXPECT_EQ(response.data(), "HTTP/1.1 200 OK\r\n" + headersResponsePart + cookiesResponsePart + "\r\n");
+}
+
+TEST(ResponseView, SharedResponseViewOutlivesInput)
+{
+    auto makeResponse = []
+    {
+        auto responseString = std::string{"HTTP/1.1 200 OK\r\nSet-Cookie: id=hello\r\nLocation: /\r\n\r\nHello world"};
+        return http::sharedResponseFromString(responseString);
+    };
+    const auto response = makeResponse();
+    ASSERT_TRUE(response);
+    EXPECT_EQ(response->status(), http::ResponseStatus::_200_Ok);
+    EXPECT_EQ(response->cookies().at(0).name(), "id");
+    EXPECT_EQ(response->cookies().at(0).value(), "hello");
+    EXPECT_EQ(response->headers().at(0).name(), "Location");
+    EXPECT_EQ(response->headers().at(0).value(), "/");
+    EXPECT_EQ(response->body(), "Hello world");
+
+    EXPECT_FALSE(http::sharedResponseFromString("Hello world"));
+}
+
+TEST(ResponseView, BodyIsNotOwned)
+{
+    static_assert(!std::is_constructible_v<http::ResponseView, http::ResponseStatus, std::string>);
+    static_assert(!std::is_constructible_v<http::ResponseView, http::ResponseStatus, std::string&&>);
+    static_assert(std::is_constructible_v<http::ResponseView, http::ResponseStatus, std::string&>);
+    static_assert(std::is_constructible_v<http::ResponseView, http::ResponseStatus, const std::string&>);
+    static_assert(std::is_constructible_v<http::ResponseView, http::ResponseStatus, const char*>);
+    static_assert(std::is_constructible_v<http::ResponseView, http::ResponseStatus, std::string_view>);
+
+    const auto body = std::string{"Hello world"};
+    const auto responseView = http::ResponseView{http::ResponseStatus::_200_Ok, body};
+    EXPECT_EQ(responseView.body().data(), body.data());
+    EXPECT_EQ(http::ResponseView(http::ResponseStatus::_200_Ok, "Hello world").body(), "Hello world");
+}
+
+TEST(ResponseView, ResponseFromStringWithLimits)
+{
+    auto responseString = std::string{"HTTP/1.1 200 OK\r\nSet-Cookie: id=hello\r\nLocation: /\r\n\r\nHello world"};
+    EXPECT_TRUE(http::responseFromString(responseString, http::ResponseMode::Http, http::ParseLimits{2}));
+    EXPECT_FALSE(http::responseFromString(responseString, http::ResponseMode::Http, http::ParseLimits{1}));
+
+    auto limits = http::ParseLimits{};
+    limits.maxHeaderLineLength = 16;
+    EXPECT_FALSE(http::responseFromString(responseString, http::ResponseMode::Http, limits));
+
+    limits = http::ParseLimits{};
+    limits.maxTotalSize = 16;
+    EXPECT_FALSE(http::responseFromString(responseString, http::ResponseMode::Http, limits));
+}
+
+TEST(ResponseView, ResponseFromStringParseErrors)
+{
+    {
+        auto response = http::responseFromString("Hello world", http::ResponseMode::Http, http::ParseLimits{});
+        ASSERT_FALSE(response);
+        EXPECT_EQ(response.error(), (http::ParseError{http::ParseErrorCode::InvalidStatusLine, 0}));
+    }
+    {
+        auto response = http::responseFromString(
+                "HTTP/1.1 200 OK\r\nLocation: /\r\nHello world\r\n\r\n",
+                http::ResponseMode::Http,
+                http::ParseLimits{});
+        ASSERT_FALSE(response);
+        EXPECT_EQ(response.error(), (http::ParseError{http::ParseErrorCode::InvalidHeader, 30}));
+    }
+}
+
+TEST(Response, DataWithContentLength)
+{
+    {
+        const auto response = http::Response{"Hello world"};
+        EXPECT_EQ(
+                response.data(http::ResponseMode::Http, {}),
+                "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nContent-Length: 11\r\n\r\nHello world");
+        EXPECT_EQ(
+                response.data(http::ResponseMode::Cgi, {}),
+                "Status: 200 OK\r\nContent-Type: text/html\r\nContent-Length: 11\r\n\r\nHello world");
+    }
+    {
+        auto response = http::Response{http::ResponseStatus::_404_Not_Found};
+        response.addCookie(http::Cookie{"name", "foo"});
+        EXPECT_EQ(
+                response.data(http::ResponseMode::Http, {}),
+                "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nSet-Cookie: name=foo\r\n\r\n");
+    }
+    {
+        const auto response = http::Response{http::ResponseStatus::_204_No_Content};
+        EXPECT_EQ(response.data(http::ResponseMode::Http, {}), "HTTP/1.1 204 No Content\r\n\r\n");
+    }
+    {
+        const auto response = http::Response{"/", http::RedirectType::NotModified};
+        EXPECT_EQ(response.data(http::ResponseMode::Http, {}), "HTTP/1.1 304 Not Modified\r\nLocation: /\r\n\r\n");
+    }
+    {
+        const auto response = http::Response{"Hello", {}, {http::Header{"content-length", "5"}}};
+        EXPECT_EQ(
+                response.data(http::ResponseMode::Http, {}),
+                "HTTP/1.1 200 OK\r\ncontent-length: 5\r\nContent-Type: text/html\r\n\r\nHello");
+    }
+}
+
+TEST(Response, DataWithDate)
+{
+    const auto response = http::Response{http::ResponseStatus::_200_Ok};
+    const auto data = response.data(http::ResponseMode::Http, {false, true});
+    const auto dateHeader = std::string{"Date: "};
+    ASSERT_EQ(data.substr(0, 17 + dateHeader.size()), "HTTP/1.1 200 OK\r\n" + dateHeader);
+    EXPECT_TRUE(http::httpDateFromString(data.substr(17 + dateHeader.size(), 29)).has_value());
+    EXPECT_EQ(data.substr(17 + dateHeader.size() + 29), "\r\n\r\n");
+
+    auto responseWithDate = http::Response{http::ResponseStatus::_200_Ok};
+    responseWithDate.addHeader(http::Header{"Date", "today"});
+    EXPECT_EQ(responseWithDate.data(http::ResponseMode::Http, {false, true}), "HTTP/1.1 200 OK\r\nDate: today\r\n\r\n");
+}
+
+TEST(Response, ContentTypeHeaderWithoutCopy)
+{
+    auto headers = std::vector<http::Header>{};
+    headers.reserve(4);
+    headers.emplace_back("Host", "HotTeacup");
+    const auto headersBuffer = headers.data();
+
+    const auto response = http::Response{"Hello world", http::ContentType::PlainText, {}, std::move(headers)};
+    EXPECT_EQ(response.headers().data(), headersBuffer);
+    EXPECT_EQ(
+            response.data(),
+            "HTTP/1.1 200 OK\r\nHost: HotTeacup\r\nContent-Type: text/plain\r\n\r\nHello world");
+}
+
+TEST(Response, KnownHeadersAreTracked)
+{
+    {
+        const auto response = http::Response{"Hello world", {}, {http::Header{"content-type", "text/plain"}}};
+        EXPECT_EQ(response.data(), "HTTP/1.1 200 OK\r\ncontent-type: text/plain\r\n\r\nHello world");
+    }
+    {
+        auto response = http::Response{"Hello world"};
+        response.addHeaders({http::Header{"Content-Length", "11"}, http::Header{"Date", "today"}});
+        EXPECT_EQ(
+                response.data(http::ResponseMode::Http, {true, true}),
+                "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nContent-Length: 11\r\nDate: today\r\n\r\nHello world");
+    }
+}
+
+TEST(Response, SetFindAndRemoveHeaders)
+{
+    auto response = http::Response{http::ResponseStatus::_200_Ok};
+    response.addHeader(http::Header{"Cache-Control", "no-cache"});
+    response.addHeader(http::Header{"Host", "HotTeacup"});
+    response.addHeader(http::Header{"cache-control", "no-store"});
+
+    ASSERT_NE(response.findHeader("CACHE-CONTROL"), nullptr);
+    EXPECT_EQ(response.findHeader("CACHE-CONTROL")->value(), "no-cache");
+    EXPECT_EQ(response.findHeader("Vary"), nullptr);
+
+    response.setHeader(http::Header{"Cache-Control", "max-age=60"});
+    EXPECT_EQ(response.data(), "HTTP/1.1 200 OK\r\nCache-Control: max-age=60\r\nHost: HotTeacup\r\n\r\n");
+
+    response.setHeader(http::Header{"Vary", "Accept-Encoding"});
+    EXPECT_EQ(
+            response.data(),
+            "HTTP/1.1 200 OK\r\nCache-Control: max-age=60\r\nHost: HotTeacup\r\nVary: Accept-Encoding\r\n\r\n");
+
+    response.removeHeader(response.findHeader("Cache-Control")->name());
+    response.removeHeader("Content-Type");
+    EXPECT_EQ(response.findHeader("Cache-Control"), nullptr);
+    EXPECT_EQ(response.data(), "HTTP/1.1 200 OK\r\nHost: HotTeacup\r\nVary: Accept-Encoding\r\n\r\n");
+}
+
+TEST(Response, RemovedKnownHeaderIsGeneratedAgain)
+{
+    auto response = http::Response{"Hello"};
+    response.setHeader(http::Header{"Content-Length", "100"});
+    EXPECT_EQ(
+            response.data(http::ResponseMode::Http, {}),
+            "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nContent-Length: 100\r\n\r\nHello");
+    response.removeHeader("content-length");
+    EXPECT_EQ(
+            response.data(http::ResponseMode::Http, {}),
+            "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nContent-Length: 5\r\n\r\nHello");
+}
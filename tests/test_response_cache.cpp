@@ -0,0 +1,111 @@
+#include <hot_teacup/request_view.h>
+#include <hot_teacup/response.h>
+#include <hot_teacup/response_cache.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(ResponseCache, StoreAndFind)
+{
+    auto cache = http::ResponseCache{};
+    EXPECT_EQ(cache.find("/test"), nullptr);
+
+    const auto data = cache.store("/test", http::Response{"Hello world"});
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(*data, "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\n\r\nHello world");
+    EXPECT_EQ(cache.find("/test"), data);
+    EXPECT_EQ(cache.find("/test", http::ResponseMode::Cgi), nullptr);
+
+    cache.store("/test", http::Response{"Hello world"}, http::ResponseMode::Cgi);
+    EXPECT_EQ(
+            *cache.find("/test", http::ResponseMode::Cgi),
+            "Status: 200 OK\r\nContent-Type: text/html\r\n\r\nHello world");
+    EXPECT_EQ(cache.size(), 2);
+
+    cache.store("/test", "updated");
+    EXPECT_EQ(*cache.find("/test"), "updated");
+    EXPECT_EQ(cache.size(), 2);
+
+    cache.remove("/test");
+    EXPECT_EQ(cache.find("/test"), nullptr);
+    EXPECT_EQ(cache.find("/test", http::ResponseMode::Cgi), nullptr);
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(ResponseCache, Expiration)
+{
+    auto cache = http::ResponseCache{{std::chrono::seconds{0}, 1024, 1024 * 1024, 1}};
+    const auto data = cache.store("/test", "data");
+    EXPECT_EQ(*data, "data");
+    EXPECT_EQ(cache.find("/test"), nullptr);
+
+    cache.store("/test2", "data");
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(ResponseCache, SizeLimits)
+{
+    {
+        auto cache = http::ResponseCache{{std::chrono::minutes{1}, 2, 1024, 1}};
+        cache.store("/1", "data");
+        cache.store("/2", "data");
+        cache.store("/3", "data");
+        EXPECT_EQ(cache.size(), 2);
+        EXPECT_EQ(cache.find("/1"), nullptr);
+        EXPECT_NE(cache.find("/2"), nullptr);
+        EXPECT_NE(cache.find("/3"), nullptr);
+    }
+    {
+        auto cache = http::ResponseCache{{std::chrono::minutes{1}, 100, 19, 1}};
+        cache.store("/1", "12345678");
+        cache.store("/2", "12345678");
+        EXPECT_EQ(cache.find("/1"), nullptr);
+        EXPECT_NE(cache.find("/2"), nullptr);
+
+        const auto data = cache.store("/3", std::string(20, 'x'));
+        EXPECT_EQ(*data, std::string(20, 'x'));
+        EXPECT_EQ(cache.find("/3"), nullptr);
+        EXPECT_NE(cache.find("/2"), nullptr);
+
+        cache.clear();
+        EXPECT_EQ(cache.size(), 0);
+        EXPECT_EQ(cache.find("/2"), nullptr);
+    }
+}
+
+TEST(ResponseCache, Key)
+{
+    const auto request = http::RequestView{"GET", {}, {}, "/test", "page=2&sort=asc&session=foo", {}, {}, {}};
+    EXPECT_EQ(http::responseCacheKey(request), "/test");
+    const auto expectedKey = std::string_view{"/test\0page=2\0sort=asc\0filter", 28};
+    EXPECT_EQ(http::responseCacheKey(request, {"page", "sort", "filter"}), expectedKey);
+    EXPECT_NE(http::responseCacheKey(request, {"sort", "page"}), http::responseCacheKey(request, {"page", "sort"}));
+}
+
+TEST(ResponseCache, ConcurrentAccess)
+{
+    auto cache = http::ResponseCache{{std::chrono::minutes{1}, 64, 1024 * 1024, 4}};
+    auto mismatchCount = std::atomic<int>{};
+    auto threads = std::vector<std::thread>{};
+    for (auto threadIndex = 0; threadIndex < 4; ++threadIndex)
+        threads.emplace_back(
+                [&cache, &mismatchCount, threadIndex]
+                {
+                    for (auto i = 0; i < 1000; ++i) {
+                        const auto key = "/" + std::to_string((i * 7 + threadIndex) % 100);
+                        if (const auto data = cache.find(key)) {
+                            if (*data != key)
+                                ++mismatchCount;
+                        }
+                        else
+                            cache.store(key, key);
+                    }
+                });
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(mismatchCount, 0);
+    EXPECT_LE(cache.size(), 64);
+}
@@ -0,0 +1,110 @@
+#include <hot_teacup/request_view.h>
+#include <hot_teacup/router.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+TEST(Router, Literals)
+{
+    auto router = http::Router{};
+    EXPECT_EQ(router.addRoute("/"), 0);
+    EXPECT_EQ(router.addRoute("/users"), 1);
+    EXPECT_EQ(router.addRoute("/users/list"), 2);
+    EXPECT_EQ(router.addRoute("/users/list/"), 3);
+
+    EXPECT_EQ(router.match("/")->routeId(), 0);
+    EXPECT_EQ(router.match("")->routeId(), 0);
+    EXPECT_EQ(router.match("/users")->routeId(), 1);
+    EXPECT_EQ(router.match("/users/list")->routeId(), 2);
+    EXPECT_EQ(router.match("/users/list/")->routeId(), 3);
+    EXPECT_FALSE(router.match("/users/"));
+    EXPECT_FALSE(router.match("/user"));
+    EXPECT_FALSE(router.match("/users/list/all"));
+    EXPECT_FALSE(router.match("/Users"));
+}
+
+TEST(Router, Params)
+{
+    auto router = http::Router{};
+    router.addRoute("/users/{id}");
+    router.addRoute("/users/{id}/posts/{postId}");
+
+    const auto match = router.match("/users/42");
+    ASSERT_TRUE(match);
+    EXPECT_EQ(match->routeId(), 0);
+    EXPECT_EQ(match->paramCount(), 1);
+    EXPECT_EQ(match->param("id"), "42");
+    EXPECT_EQ(match->param(0), "42");
+    EXPECT_EQ(match->param("postId"), "");
+    EXPECT_EQ(match->param(1), "");
+
+    const auto postMatch = router.match("/users/42/posts/7");
+    ASSERT_TRUE(postMatch);
+    EXPECT_EQ(postMatch->routeId(), 1);
+    EXPECT_EQ(postMatch->param("id"), "42");
+    EXPECT_EQ(postMatch->param("postId"), "7");
+
+    EXPECT_FALSE(router.match("/users"));
+    EXPECT_FALSE(router.match("/users/"));
+    EXPECT_FALSE(router.match("/users//posts/7"));
+    EXPECT_FALSE(router.match("/users/42/posts"));
+}
+
+TEST(Router, Wildcard)
+{
+    auto router = http::Router{};
+    router.addRoute("/static/*");
+    router.addRoute("/*");
+
+    const auto match = router.match("/static/css/main.css");
+    ASSERT_TRUE(match);
+    EXPECT_EQ(match->routeId(), 0);
+    EXPECT_EQ(match->wildcard(), "css/main.css");
+    EXPECT_EQ(match->paramCount(), 0);
+
+    EXPECT_EQ(router.match("/static/")->routeId(), 0);
+    EXPECT_EQ(router.match("/static/")->wildcard(), "");
+    EXPECT_EQ(router.match("/static")->routeId(), 1);
+    EXPECT_EQ(router.match("/static")->wildcard(), "static");
+    EXPECT_FALSE(router.match("/"));
+}
+
+TEST(Router, Precedence)
+{
+    auto router = http::Router{};
+    router.addRoute("/users/{id}/profile");
+    router.addRoute("/users/me");
+    router.addRoute("/users/*");
+    router.addRoute("/users/{id}");
+
+    EXPECT_EQ(router.match("/users/me")->routeId(), 1);
+    EXPECT_EQ(router.match("/users/42")->routeId(), 3);
+    EXPECT_EQ(router.match("/users/me/profile")->routeId(), 0);
+    EXPECT_EQ(router.match("/users/me/profile")->param("id"), "me");
+    EXPECT_EQ(router.match("/users/42/settings")->routeId(), 2);
+    EXPECT_EQ(router.match("/users/42/settings")->wildcard(), "42/settings");
+    EXPECT_EQ(router.match("/users/42/settings")->param("id"), "");
+}
+
+TEST(Router, MatchRequest)
+{
+    auto router = http::Router{};
+    router.addRoute("/test/{name}");
+    const auto request = http::RequestView{"GET", {}, {}, "/test/foo?name=bar", {}, {}, {}, {}};
+    const auto match = router.match(request);
+    ASSERT_TRUE(match);
+    EXPECT_EQ(match->param("name"), "foo");
+}
+
+TEST(Router, InvalidPatterns)
+{
+    auto router = http::Router{};
+    router.addRoute("/users/{id}");
+    EXPECT_THROW(router.addRoute("/users/{name}"), std::invalid_argument);
+    EXPECT_THROW(router.addRoute("/users/*/posts"), std::invalid_argument);
+    EXPECT_THROW(router.addRoute("/users/{}"), std::invalid_argument);
+    EXPECT_THROW(router.addRoute("/users/{id"), std::invalid_argument);
+    EXPECT_THROW(router.addRoute("/users/id*"), std::invalid_argument);
+    EXPECT_THROW(router.addRoute("/{a}/{b}/{c}/{d}/{e}/{f}/{g}/{h}/{i}"), std::invalid_argument);
+    EXPECT_EQ(router.addRoute("/{a}/{b}/{c}/{d}/{e}/{f}/{g}/{h}"), 1);
+    EXPECT_EQ(router.match("/1/2/3/4/5/6/7/8")->param("h"), "8");
+}
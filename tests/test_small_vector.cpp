@@ -0,0 +1,119 @@
+#include <hot_teacup/small_vector.h>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+TEST(SmallVector, InlineStorage)
+{
+    auto items = http::SmallVector<std::string, 2>{};
+    EXPECT_TRUE(items.empty());
+    items.emplace_back("foo");
+    items.push_back("bar");
+    const auto inlineData = items.data();
+    EXPECT_EQ(items.size(), 2);
+    EXPECT_EQ(items.capacity(), 2);
+    EXPECT_EQ(items.front(), "foo");
+    EXPECT_EQ(items.back(), "bar");
+    EXPECT_THROW(items.at(2), std::out_of_range);
+
+    items.emplace_back(items.front());
+    EXPECT_NE(items.data(), inlineData);
+    EXPECT_EQ(items.size(), 3);
+    EXPECT_EQ(items.capacity(), 4);
+    EXPECT_EQ(items[2], "foo");
+
+    items.clear();
+    EXPECT_TRUE(items.empty());
+}
+
+TEST(SmallVector, CopyAndMove)
+{
+    const auto items = http::SmallVector<std::string, 2>{"foo", "bar", "baz"};
+    auto copiedItems = items;
+    ASSERT_EQ(copiedItems.size(), 3);
+    EXPECT_EQ(copiedItems[2], "baz");
+
+    const auto heapData = copiedItems.data();
+    auto movedItems = std::move(copiedItems);
+    EXPECT_EQ(movedItems.data(), heapData);
+    EXPECT_TRUE(copiedItems.empty());
+    EXPECT_EQ(copiedItems.capacity(), 2);
+
+    auto inlineItems = http::SmallVector<std::string, 2>{"foo"};
+    movedItems = std::move(inlineItems);
+    ASSERT_EQ(movedItems.size(), 1);
+    EXPECT_EQ(movedItems[0], "foo");
+    EXPECT_EQ(movedItems.capacity(), 2);
+
+    movedItems = items;
+    ASSERT_EQ(movedItems.size(), 3);
+    EXPECT_EQ(movedItems[1], "bar");
+}
+
+TEST(SmallVector, VectorInterface)
+{
+    const auto items = http::SmallVector<std::string, 2>{"foo", "bar", "baz"};
+    EXPECT_EQ(std::vector<std::string>(items.cbegin(), items.cend()), (std::vector<std::string>{"foo", "bar", "baz"}));
+    EXPECT_EQ(std::vector<std::string>(items.rbegin(), items.rend()), (std::vector<std::string>{"baz", "bar", "foo"}));
+    EXPECT_EQ(std::distance(items.crbegin(), items.crend()), 3);
+
+    EXPECT_EQ(items, (http::SmallVector<std::string, 2>{"foo", "bar", "baz"}));
+    EXPECT_NE(items, (http::SmallVector<std::string, 2>{"foo", "bar"}));
+
+    const auto vector = static_cast<std::vector<std::string>>(items);
+    EXPECT_EQ(vector, (std::vector<std::string>{"foo", "bar", "baz"}));
+    const auto convertedItems = http::SmallVector<std::string, 2>{vector};
+    EXPECT_EQ(convertedItems, items);
+    static_assert(!std::is_convertible_v<std::vector<std::string>, http::SmallVector<std::string, 2>>);
+    static_assert(!std::is_convertible_v<http::SmallVector<std::string, 2>, std::vector<std::string>>);
+}
+
+namespace {
+struct ThrowingCopy {
+    ThrowingCopy(std::string value, bool throwOnCopy = false)
+        : value{std::move(value)}
+        , throwOnCopy{throwOnCopy}
+    {
+    }
+
+    ThrowingCopy(const ThrowingCopy& other)
+        : value{other.value}
+        , throwOnCopy{other.throwOnCopy}
+    {
+        if (throwOnCopy)
+            throw std::runtime_error{"copy failed"};
+    }
+
+    //not noexcept, so the elements are copied when the storage grows
+    ThrowingCopy(ThrowingCopy&& other)
+        : value{std::move(other.value)}
+        , throwOnCopy{other.throwOnCopy}
+    {
+    }
+
+    std::string value;
+    bool throwOnCopy;
+};
+} //namespace
+
+TEST(SmallVector, ReallocationKeepsElementsOnException)
+{
+    auto items = http::SmallVector<ThrowingCopy, 2>{};
+    items.emplace_back("foo");
+    items.emplace_back("bar", true);
+    EXPECT_THROW(items.emplace_back("baz"), std::runtime_error);
+    ASSERT_EQ(items.size(), 2);
+    EXPECT_EQ(items.capacity(), 2);
+    EXPECT_EQ(items[0].value, "foo");
+    EXPECT_EQ(items[1].value, "bar");
+
+    items[1].throwOnCopy = false;
+    items.emplace_back("baz");
+    ASSERT_EQ(items.size(), 3);
+    EXPECT_EQ(items[0].value, "foo");
+    EXPECT_EQ(items[2].value, "baz");
+}